@@ -1,6 +1,7 @@
 package direwolf
 
 import (
+	"bytes"
 	"encoding/binary"
 	"io"
 )
@@ -38,3 +39,19 @@ func (msg *AGWPEMessage) Write(w io.Writer, order binary.ByteOrder) (int, error)
 
 	return 0, nil
 }
+
+// Serialize to a single buffer.  When the same message goes to several
+// clients this lets us marshal it once and give each client one gathered
+// socket write, rather than re-marshalling the header for every client.
+func (msg *AGWPEMessage) Bytes(order binary.ByteOrder) []byte {
+	var buf bytes.Buffer
+
+	// Writing a fixed-size struct to a Buffer cannot fail.
+	_ = binary.Write(&buf, order, msg.Header)
+
+	if msg.Header.DataLen > 0 {
+		buf.Write(msg.Data)
+	}
+
+	return buf.Bytes()
+}
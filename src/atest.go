@@ -46,8 +46,12 @@ import (
 	"io"
 	"math"
 	"os"
+	"os/exec"
+	"regexp"
+	"slices"
 	"strconv"
 	"strings"
+	"sync"
 	"time"
 	"unicode"
 	"unsafe"
@@ -169,6 +173,7 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 Higher values = Try modifying more bits to get a good CRC.`)
 	var errorIfLessThan = pflag.IntP("error-if-less-than", "L", -1, "Error if less than this number decoded.")
 	var errorIfGreaterThan = pflag.IntP("error-if-greater-than", "G", -1, "Error if greater than this number decoded.")
+	var parallel = pflag.IntP("parallel", "p", 0, "Process multiple WAV files in parallel with this many worker processes.  Default is one at a time in this process.")
 	var channel0 = pflag.BoolP("channel-0", "0", false, "Use channel 0 (left) of stereo audio (default).")
 	var channel1 = pflag.BoolP("channel-1", "1", false, "Use channel 1 (right) of stereo audio.")
 	var channel2 = pflag.BoolP("channel-2", "2", false, "Use both channels of stereo audio.")
@@ -198,6 +203,8 @@ o = DCD output control
 		fmt.Fprintf(os.Stderr, "$ gen_packets -B 9600 -o test9.wav\n")
 		fmt.Fprintf(os.Stderr, "$ atest -B 9600 test9.wav\n")
 		fmt.Fprintf(os.Stderr, "\n")
+		fmt.Fprintf(os.Stderr, "$ atest -p 8 track01.wav track02.wav ... track99.wav\n")
+		fmt.Fprintf(os.Stderr, "\n")
 		fmt.Fprintf(os.Stderr, "Try different combinations of options to compare decoding performance.\n")
 	}
 
@@ -426,6 +433,16 @@ o = DCD output control
 		os.Exit(1)
 	}
 
+	/*
+	 * The demodulator state is all package level, one set per channel,
+	 * so a single process can only work through the files serially.
+	 * For a large regression corpus we shard the files across child
+	 * processes instead and aggregate their decode counts here.
+	 */
+	if *parallel > 1 && len(pflag.Args()) > 1 {
+		os.Exit(atest_parallel(*parallel, *errorIfLessThan, *errorIfGreaterThan))
+	}
+
 	FX25Init(d_x_opt)
 	il2p_init(d_2_opt)
 
@@ -624,6 +641,13 @@ o = DCD output control
 			/* process_rec_frame, below, is called. */
 		}
 
+		/* If decoding in parallel, push any partial sample block */
+		/* through so frames near the end of the file are counted. */
+
+		for c := 0; c < (my_audio_config.adev[0].num_channels); c++ {
+			multi_modem_flush(c)
+		}
+
 		text_color_set(DW_COLOR_INFO)
 		fmt.Printf("\n\n")
 
@@ -668,6 +692,182 @@ o = DCD output control
 	}
 }
 
+/*-------------------------------------------------------------------
+ *
+ * Name:        atest_parallel
+ *
+ * Purpose:     Shard multiple WAV files across worker processes.
+ *
+ * Inputs:	nworkers - Number of files to process at once.
+ *
+ *		error_if_less_than, error_if_greater_than - Pass/fail
+ *			thresholds applied to the aggregate decode count.
+ *
+ * Returns:	Process exit code, 0 for success.
+ *
+ * Description:	Each worker runs this same executable on a single file
+ *		with the same options, captures its output, and extracts
+ *		the decode count.  Per-file counts and the aggregate are
+ *		reported at the end.  A 200 file corpus that takes 40+
+ *		minutes serially finishes in a few minutes on a many-core
+ *		build machine this way.
+ *
+ *--------------------------------------------------------------------*/
+
+var atest_decoded_re = regexp.MustCompile(`(?m)^([0-9]+) packets decoded`)
+var atest_duration_re = regexp.MustCompile(`Duration = ([0-9.]+) seconds`)
+
+func atest_parallel(nworkers int, error_if_less_than int, error_if_greater_than int) int {
+	var exe, exeErr = os.Executable()
+	if exeErr != nil {
+		text_color_set(DW_COLOR_ERROR)
+		fmt.Printf("Can't determine own executable for worker processes: %s\n", exeErr)
+
+		return 1
+	}
+
+	/*
+	 * Same options for every worker, minus the file names, the corpus
+	 * pass/fail thresholds, and the parallel option itself.
+	 */
+	var base_args []string
+	var skip_value = false
+
+	for _, arg := range os.Args[1:] {
+		if skip_value {
+			skip_value = false
+			continue
+		}
+
+		switch {
+		case arg == "-L" || arg == "--error-if-less-than" ||
+			arg == "-G" || arg == "--error-if-greater-than" ||
+			arg == "-p" || arg == "--parallel":
+			skip_value = true
+
+		case strings.HasPrefix(arg, "--error-if-less-than=") ||
+			strings.HasPrefix(arg, "--error-if-greater-than=") ||
+			strings.HasPrefix(arg, "--parallel=") ||
+			strings.HasPrefix(arg, "-L") && len(arg) > 2 ||
+			strings.HasPrefix(arg, "-G") && len(arg) > 2 ||
+			strings.HasPrefix(arg, "-p") && len(arg) > 2:
+			/* Value attached to the option.  Drop. */
+
+		case slices.Contains(pflag.Args(), arg):
+			/* File name.  Supplied one per worker below. */
+
+		default:
+			base_args = append(base_args, arg)
+		}
+	}
+
+	type atest_result_t struct {
+		decoded  int
+		filetime float64
+		output   []byte
+		err      error
+	}
+
+	var files = pflag.Args()
+	var jobs = make(chan string, len(files))
+
+	for _, f := range files {
+		jobs <- f
+	}
+
+	close(jobs)
+
+	var results_mutex sync.Mutex
+	var results = make(map[string]atest_result_t, len(files))
+
+	var start_time = time.Now()
+
+	var wg sync.WaitGroup
+	for range nworkers {
+		wg.Add(1)
+
+		go func() {
+			defer wg.Done()
+
+			for file := range jobs {
+				var cmd = exec.Command(exe, append(slices.Clone(base_args), file)...) //nolint:gosec // Re-running ourselves with CLI-supplied names is the point.
+				var out, runErr = cmd.CombinedOutput()
+
+				var r = atest_result_t{output: out, err: runErr} //nolint:exhaustruct
+
+				if m := atest_decoded_re.FindSubmatch(out); m != nil {
+					r.decoded, _ = strconv.Atoi(string(m[1]))
+				} else if r.err == nil {
+					r.err = errors.New("no decode count in output")
+				}
+
+				if m := atest_duration_re.FindSubmatch(out); m != nil {
+					r.filetime, _ = strconv.ParseFloat(string(m[1]), 64)
+				}
+
+				results_mutex.Lock()
+				results[file] = r
+				results_mutex.Unlock()
+			}
+		}()
+	}
+
+	wg.Wait()
+
+	var elapsed = time.Since(start_time)
+
+	/*
+	 * Report in the order the files were given, not completion order.
+	 */
+	var packets_decoded_total = 0
+	var total_filetime float64
+	var failed = false
+
+	text_color_set(DW_COLOR_INFO)
+
+	for _, file := range files {
+		var r = results[file]
+
+		if r.err != nil {
+			text_color_set(DW_COLOR_ERROR)
+			fmt.Printf("---- %s failed: %s ----\n", file, r.err)
+			os.Stdout.Write(r.output)
+			text_color_set(DW_COLOR_INFO)
+
+			failed = true
+
+			continue
+		}
+
+		fmt.Printf("%6d from %s\n", r.decoded, file)
+
+		packets_decoded_total += r.decoded
+		total_filetime += r.filetime
+	}
+
+	fmt.Printf("%d packets decoded in %.3f seconds.  %.1f x realtime\n", packets_decoded_total, elapsed.Seconds(), total_filetime/elapsed.Seconds())
+
+	if error_if_less_than != -1 && packets_decoded_total < error_if_less_than {
+		text_color_set(DW_COLOR_ERROR)
+		fmt.Printf("\n * * * TEST FAILED: number decoded is less than %d * * * \n", error_if_less_than)
+
+		failed = true
+	}
+
+	if error_if_greater_than != -1 && packets_decoded_total > error_if_greater_than {
+		text_color_set(DW_COLOR_ERROR)
+		fmt.Printf("\n * * * TEST FAILED: number decoded is greater than %d * * * \n", error_if_greater_than)
+
+		failed = true
+	}
+
+	if failed {
+		return 1
+	}
+
+	return 0
+} /* end atest_parallel */
+
 /*
  * Simulate sample from the audio device.
  */
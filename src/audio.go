@@ -541,6 +541,10 @@ type audioRingBuffer struct {
 	cond     *sync.Cond
 	overflow bool // set when data is dropped due to full buffer
 	closed   bool
+
+	// Overrun accounting since the last checkOverflow call.
+	overrunEvents int // write calls that had to drop data
+	overrunBytes  int // total bytes dropped
 }
 
 func newAudioRingBuffer(size int) *audioRingBuffer {
@@ -570,9 +574,11 @@ func (rb *audioRingBuffer) write(data []byte) bool { //nolint:unparam
 	}
 
 	var overflow = false
+	var dropped = 0
 
 	// If incoming data is larger than the whole buffer, keep only the most-recent rb.size bytes.
 	if n >= rb.size {
+		dropped = rb.count + (n - rb.size)
 		data = data[n-rb.size:]
 		n = rb.size
 		overflow = true
@@ -587,6 +593,7 @@ func (rb *audioRingBuffer) write(data []byte) bool { //nolint:unparam
 		var drop = n - free
 		rb.readPos = (rb.readPos + drop) % rb.size
 		rb.count -= drop
+		dropped += drop
 		overflow = true
 	}
 
@@ -607,6 +614,8 @@ func (rb *audioRingBuffer) write(data []byte) bool { //nolint:unparam
 
 	if overflow {
 		rb.overflow = true
+		rb.overrunEvents++
+		rb.overrunBytes += dropped
 	}
 
 	rb.cond.Signal()
@@ -652,14 +661,19 @@ func (rb *audioRingBuffer) readChunk(dst []byte) (int, bool) {
 	return n, true
 }
 
-// checkOverflow returns and clears the overflow flag.
-func (rb *audioRingBuffer) checkOverflow() bool {
+// checkOverflow returns and clears the overflow flag, along with the number
+// of overrun events and bytes dropped since the previous call.
+func (rb *audioRingBuffer) checkOverflow() (bool, int, int) {
 	rb.mu.Lock()
 	defer rb.mu.Unlock()
 	var overflow = rb.overflow
+	var events = rb.overrunEvents
+	var dropped = rb.overrunBytes
 	rb.overflow = false
+	rb.overrunEvents = 0
+	rb.overrunBytes = 0
 
-	return overflow
+	return overflow, events, dropped
 }
 
 // close signals that no more data will be written.
@@ -1410,12 +1424,15 @@ func audio_get_real(a int) int {
 		Assert(adev[a].inputRingBuf != nil)
 
 		// Check for overflow (data was dropped in the callback)
-		if adev[a].inputRingBuf.checkOverflow() {
+		var overflow, overrun_events, overrun_bytes = adev[a].inputRingBuf.checkOverflow()
+		if overflow {
 			text_color_set(DW_COLOR_ERROR)
 			dw_printf("Audio input overflow on device %d - some samples lost\n", a)
 			dw_printf("If receiving is fine and strange things happen when transmitting, it is probably RF energy\n")
 			dw_printf("getting into your audio or digital wiring.\n")
 
+			audio_stats_overrun(a, overrun_events, overrun_bytes)
+
 			audio_stats(a,
 				save_audio_config_p.adev[a].num_channels,
 				0,
@@ -1558,6 +1575,48 @@ func audio_put_real(a int, c uint8) int {
 	return (0)
 } /* end audio_put */
 
+/*------------------------------------------------------------------
+ *
+ * Name:        audio_put_block
+ *
+ * Purpose:     Send a block of bytes to the audio device.
+ *
+ * Inputs:	a
+ *
+ *		block	- Bytes in the same layout audio_put expects.
+ *
+ * Returns:     Normally non-negative.
+ *              -1 for any type of error.
+ *
+ * Description:	Equivalent to calling audio_put for each byte, but
+ *		fills the output buffer with bulk copies so the
+ *		modulator can hand over a whole symbol of samples
+ *		in one call.
+ *
+ * See Also:	audio_put
+ *		audio_flush
+ *
+ *----------------------------------------------------------------*/
+
+func audio_put_block_real(a int, block []byte) int {
+	for len(block) > 0 {
+		/* Should never be full at this point. */
+		Assert(adev[a].outbufLen < adev[a].outbufSizeInBytes)
+
+		var n = copy(adev[a].outbuf[adev[a].outbufLen:adev[a].outbufSizeInBytes], block)
+		adev[a].outbufLen += n
+		block = block[n:]
+
+		if adev[a].outbufLen == adev[a].outbufSizeInBytes {
+			if audio_flush(a) < 0 {
+				return -1
+			}
+		}
+	}
+
+	return (0)
+} /* end audio_put_block */
+
 /*------------------------------------------------------------------
  *
  * Name:        audio_flush
@@ -30,6 +30,7 @@ package direwolf
  *---------------------------------------------------------------*/
 
 import (
+	"fmt"
 	"time"
 )
 
@@ -59,6 +60,42 @@ var audioStatsLastTime [MAX_ADEVS]time.Time
 var audioStatsSampleCount [MAX_ADEVS]int
 var audioStatsErrorCount [MAX_ADEVS]int
 var audioStatsSuppressFirst [MAX_ADEVS]bool
+var audioStatsOverrunCount [MAX_ADEVS]int
+var audioStatsOverrunBytes [MAX_ADEVS]int
+
+/*------------------------------------------------------------------
+*
+* Name:        audio_stats_overrun
+*
+* Purpose:     Record that the audio capture buffer overflowed and
+*		samples were lost.
+*
+* Inputs:	adev	- Audio device number:  0, 1, ..., MAX_ADEVS-1
+*
+*		events	- Number of times data was dropped.
+*
+*		dropped_bytes - How many bytes were lost.
+*
+* Description:	The capture ring buffer is filled by the sound system
+*		in large periods and drained by the demodulators.  If the
+*		demodulators fall behind, for example due to scheduling
+*		gaps on a loaded system, the oldest samples are dropped
+*		and counted here.  The totals appear in the periodic
+*		report so the condition is visible, not just a mystery
+*		of occasional missed frames.
+*
+*		There is no corresponding underrun case for capture:
+*		an empty buffer simply means we are keeping up and the
+*		reader waits for more.
+*
+*----------------------------------------------------------------*/
+
+func audio_stats_overrun(adev int, events int, dropped_bytes int) {
+	Assert(adev >= 0 && adev < MAX_ADEVS)
+
+	audioStatsOverrunCount[adev] += events
+	audioStatsOverrunBytes[adev] += dropped_bytes
+}
 
 func audio_stats(adev int, nchan int, nsamp int, interval int) {
 	/* Gather numbers for read from audio device. */
@@ -104,6 +141,12 @@ func audio_stats(adev int, nchan int, nsamp int, interval int) {
 			} else {
 				var ave_rate = (float64(audioStatsSampleCount[adev]) / 1000.0) / float64(interval)
 
+				/* Mention capture overruns only when they happened. */
+				var sover = ""
+				if audioStatsOverrunCount[adev] > 0 {
+					sover = fmt.Sprintf(", %d overruns (%d bytes lost)", audioStatsOverrunCount[adev], audioStatsOverrunBytes[adev])
+				}
+
 				text_color_set(DW_COLOR_DEBUG)
 
 				if nchan > 1 {
@@ -112,20 +155,22 @@ func audio_stats(adev int, nchan int, nsamp int, interval int) {
 					var ch1 = ADEVFIRSTCHAN(adev) + 1
 					var alevel1 = demod_get_audio_level(ch1, 0)
 
-					dw_printf("\nADEVICE%d: Sample rate approx. %.1f k, %d errors, receive audio levels CH%d %d, CH%d %d\n\n",
-						adev, ave_rate, audioStatsErrorCount[adev], ch0, alevel0.rec, ch1, alevel1.rec)
+					dw_printf("\nADEVICE%d: Sample rate approx. %.1f k, %d errors%s, receive audio levels CH%d %d, CH%d %d\n\n",
+						adev, ave_rate, audioStatsErrorCount[adev], sover, ch0, alevel0.rec, ch1, alevel1.rec)
 				} else {
 					var ch0 = ADEVFIRSTCHAN(adev)
 					var alevel0 = demod_get_audio_level(ch0, 0)
 
-					dw_printf("\nADEVICE%d: Sample rate approx. %.1f k, %d errors, receive audio level CH%d %d\n\n",
-						adev, ave_rate, audioStatsErrorCount[adev], ch0, alevel0.rec)
+					dw_printf("\nADEVICE%d: Sample rate approx. %.1f k, %d errors%s, receive audio level CH%d %d\n\n",
+						adev, ave_rate, audioStatsErrorCount[adev], sover, ch0, alevel0.rec)
 				}
 			}
 
 			audioStatsLastTime[adev] = this_time
 			audioStatsSampleCount[adev] = 0
 			audioStatsErrorCount[adev] = 0
+			audioStatsOverrunCount[adev] = 0
+			audioStatsOverrunBytes[adev] = 0
 		}
 	}
 }
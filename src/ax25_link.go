@@ -394,6 +394,10 @@ type ax25_dlsm_t struct {
 	t1_had_expired bool // Set when T1 expires.
 	// Cleared for start & stop.
 
+	t1_seq int // Timer wheel schedule sequence number.  See ax25_timer_wheel.go.
+	// Incremented on every start / stop / pause / resume so stale
+	// wheel entries can be recognized and discarded lazily.
+
 	// Timer T3.
 
 	// T3 is used to terminate connection after extended inactivity.
@@ -403,6 +407,8 @@ type ax25_dlsm_t struct {
 
 	t3_exp time.Time // When it expires or 0 if not running.
 
+	t3_seq int // Timer wheel schedule sequence number, like t1_seq.
+
 	// Statistics for testing purposes.
 
 	// Count how many frames of each type we received.
@@ -434,6 +440,16 @@ type ax25_dlsm_t struct {
 
 	magic2 int // Look out for out of bounds for above.
 
+	srej_pending [128]bool // Sequence numbers noticed missing while processing
+	// an incoming transmission.  Indexed by N(S).
+	// Instead of sending SREJ immediately for each gap,
+	// these are accumulated and sent as one batch, after
+	// the carrier drops, in lm_seize_confirm.  A single
+	// Multi-SREJ can then cover all of them if the other
+	// end negotiated that capability.
+
+	srej_pending_count int // Number set in array above.
+
 	// "Management Data Link"  (MDL) state machine for XID exchange.
 
 	mdl_state mdl_state_e
@@ -448,6 +464,8 @@ type ax25_dlsm_t struct {
 
 	tm201_paused_at time.Time // Time when it was paused or 0 if not paused.
 
+	tm201_seq int // Timer wheel schedule sequence number, like t1_seq.
+
 	// Segment reassembler.
 
 	ra_buff *cdata_t // Reassembler buffer.  nil when in ready state.
@@ -1857,6 +1875,12 @@ func lm_seize_confirm(E *dlq_item_t) {
 				// Nothing to be done
 
 			case state_3_connected, state_4_timer_recovery:
+				// Ask for anything noticed missing during the transmission which
+				// just ended.  Deferring until here, rather than sending SREJ as
+				// each gap was noticed, lets one batch (or one Multi-SREJ) cover
+				// the whole transmission without redundant requests.
+				send_pending_srej(S)
+
 				// v1.5 change in strategy.
 				// New I frames, not sent yet, are delayed until after processing anything in the received transmission.
 				// Previously we started sending new frames, from the client app, as soon as they arrived.
@@ -2417,6 +2441,7 @@ func i_frame_continued(S *ax25_dlsm_t, p int, ns int, pid int, info []byte) {
 		// sequence numbers.  If so, process them too.
 		SET_VR(S, AX25MODULO(S.vr+1, S.modulo))
 		S.reject_exception = false
+		srej_pending_clear(S, ns)
 
 		if s_debug_client_app {
 			text_color_set(DW_COLOR_DEBUG)
@@ -2450,6 +2475,7 @@ func i_frame_continued(S *ax25_dlsm_t, p int, ns int, pid int, info []byte) {
 
 			cdata_delete(S.rxdata_by_ns[S.vr])
 			S.rxdata_by_ns[S.vr] = nil
+			srej_pending_clear(S, S.vr)
 
 			SET_VR(S, AX25MODULO(S.vr+1, S.modulo))
 		}
@@ -2538,6 +2564,7 @@ func i_frame_continued(S *ax25_dlsm_t, p int, ns int, pid int, info []byte) {
 			}
 
 			S.rxdata_by_ns[ns] = cdata_new(pid, info)
+			srej_pending_clear(S, ns)
 
 			if s_debug_misc {
 				dw_printf("save to rxdata_by_ns N(S)=%d, V(R)=%d, \"", ns, S.vr)
@@ -2575,20 +2602,14 @@ func i_frame_continued(S *ax25_dlsm_t, p int, ns int, pid int, info []byte) {
 				// Version 1.5:
 				// Don't generate duplicate requests for gaps in the same transmission.
 
-				// Ideally, we might wait until carrier drops and then use one Multi-SREJ for entire transmission but
-				// we will keep that for another day.
-				// Probably need a flag similar to acknowledge_pending (or ask_resend_count, here) and the ask_for_resend array.
-				// It could then be processed first in lm_seize_confirm.
-				var ask_for_resend [128]int
-				var ask_resend_count = 0
-
-				// Version 1.5
-				// Erratum:  AX.25 says use F=0 here.  Doesn't make sense.
-				// We would want to set F when sending N(R) = V(R).
-				//	      int allow_f1 = 0;		// F=1 from X.25 2.4.6.4 b) 3)
-				var allow_f1 = true // F=1 from X.25 2.4.6.4 b) 3)
+				// Upstream had a TODO here:  "Ideally, we might wait until carrier drops
+				// and then use one Multi-SREJ for entire transmission."  That is what we
+				// do now.  The gap is only recorded here.  lm_seize_confirm, which fires
+				// when the channel becomes available to us, prunes out anything filled
+				// in by the rest of the transmission and sends what is still missing as
+				// one batch.  See send_pending_srej.
 
-				// send only for this gap, not cumulative from V(R).
+				// Record only this gap, not cumulative from V(R).
 
 				var last = AX25MODULO(ns-1, S.modulo)
 
@@ -2597,10 +2618,14 @@ func i_frame_continued(S *ax25_dlsm_t, p int, ns int, pid int, info []byte) {
 					first = AX25MODULO(first-1, S.modulo)
 				}
 
+				var had_pending = S.srej_pending_count > 0
+
 				var x = first
 				for {
-					ask_for_resend[ask_resend_count] = AX25MODULO(x, S.modulo)
-					ask_resend_count++
+					if !S.srej_pending[x] {
+						S.srej_pending[x] = true
+						S.srej_pending_count++
+					}
 
 					x = AX25MODULO(x+1, S.modulo)
 					if !(x != AX25MODULO(last+1, S.modulo)) {
@@ -2608,7 +2633,12 @@ func i_frame_continued(S *ax25_dlsm_t, p int, ns int, pid int, info []byte) {
 					}
 				}
 
-				send_srej_frames(S, ask_for_resend[:ask_resend_count], ask_resend_count, allow_f1)
+				if !had_pending {
+					// Force start of transmission even if the transmit frame queue
+					// is empty so lm_seize_confirm will arrive.  Same technique as
+					// the acknowledge_pending case.
+					lm_seize_request(S.channel)
+				}
 			}
 		} else {
 			// X.25 2.4.6.4 a)
@@ -2792,6 +2822,78 @@ func is_ns_in_window(S *ax25_dlsm_t, ns int) bool {
 	return (result)
 }
 
+/*------------------------------------------------------------------------------
+ *
+ * Name:	srej_pending_clear
+ *
+ * Purpose:	Remove a sequence number from the deferred SREJ list.
+ *
+ * Description:	Called whenever an I frame is received, whether delivered in
+ *		sequence or saved in the receive buffer, so we don't ask for a
+ *		resend of something that showed up later in the same transmission.
+ *
+ *------------------------------------------------------------------------------*/
+
+func srej_pending_clear(S *ax25_dlsm_t, ns int) {
+	if S.srej_pending[ns] {
+		S.srej_pending[ns] = false
+		S.srej_pending_count--
+	}
+}
+
+/*------------------------------------------------------------------------------
+ *
+ * Name:	send_pending_srej
+ *
+ * Purpose:	Ask for all I frames noticed missing during the transmission
+ *		which just ended.
+ *
+ * Description:	Gaps are recorded in srej_pending as incoming I frames are
+ *		processed, rather than sending SREJ right away.  This is called
+ *		from lm_seize_confirm, once the other station has stopped
+ *		transmitting and the channel is ours, so one batch covers the
+ *		entire transmission.  Anything filled in by a later frame in the
+ *		same transmission, or no longer in the receive window, is
+ *		dropped.  When Multi-SREJ was negotiated, the whole batch goes
+ *		out in a single frame.
+ *
+ *------------------------------------------------------------------------------*/
+
+func send_pending_srej(S *ax25_dlsm_t) {
+	if S.srej_pending_count == 0 {
+		return
+	}
+
+	var ask_for_resend [128]int
+	var ask_resend_count = 0
+
+	// Walk forward from V(R) so the requests are in ascending order relative
+	// to the receive window and stale entries behind it are skipped.
+	// With modulo 8 (SREJ can be negotiated there too) the window is
+	// smaller than GENEROUS_K; don't wrap around and revisit residues.
+
+	for offset := range min(GENEROUS_K, int(S.modulo)-1) {
+		var n = AX25MODULO(S.vr+offset, S.modulo)
+		if S.srej_pending[n] && S.rxdata_by_ns[n] == nil {
+			ask_for_resend[ask_resend_count] = n
+			ask_resend_count++
+		}
+	}
+
+	for n := range 128 {
+		S.srej_pending[n] = false
+	}
+	S.srej_pending_count = 0
+
+	if ask_resend_count > 0 {
+		// Erratum:  AX.25 says use F=0 here.  Doesn't make sense.
+		// We would want to set F when sending N(R) = V(R).
+		var allow_f1 = true // F=1 from X.25 2.4.6.4 b) 3)
+
+		send_srej_frames(S, ask_for_resend[:ask_resend_count], ask_resend_count, allow_f1)
+	}
+} /* end send_pending_srej */
+
 /*------------------------------------------------------------------------------
  *
  * Name:	send_srej_frames
@@ -4630,37 +4732,15 @@ func test_frame(S *ax25_dlsm_t, cr cmdres_t, pf int, info []byte) {
  *------------------------------------------------------------------------------*/
 
 func dl_timer_expiry() {
-	var now = time.Now()
-
-	// Examine all of the data link state machines.
-	// Process only those where timer:
+	// The timer wheel knows which timers are due without scanning
+	// all of the data link state machines.  It processes only those
+	// where the timer:
 	//	- is running.
 	//	- is not paused.
 	//	- expiration time has arrived or passed.
+	// See ax25_timer_wheel.go.
 
-	for p := list_head; p != nil; p = p.next {
-		if !p.t1_exp.IsZero() && p.t1_paused_at.IsZero() && !p.t1_exp.After(now) {
-			p.t1_exp = time.Time{}
-			p.t1_paused_at = time.Time{}
-			p.t1_had_expired = true
-			t1_expiry(p)
-		}
-	}
-
-	for p := list_head; p != nil; p = p.next {
-		if !p.t3_exp.IsZero() && !p.t3_exp.After(now) {
-			p.t3_exp = time.Time{}
-			t3_expiry(p)
-		}
-	}
-
-	for p := list_head; p != nil; p = p.next {
-		if !p.tm201_exp.IsZero() && p.tm201_paused_at.IsZero() && !p.tm201_exp.After(now) {
-			p.tm201_exp = time.Time{}
-			p.tm201_paused_at = time.Time{}
-			tm201_expiry(p)
-		}
-	}
+	timer_wheel_fire()
 } /* end dl_timer_expiry */
 
 /*------------------------------------------------------------------------------
@@ -5014,8 +5094,12 @@ func clear_exception_conditions(S *ax25_dlsm_t) {
 			cdata_delete(S.rxdata_by_ns[n])
 			S.rxdata_by_ns[n] = nil
 		}
+
+		S.srej_pending[n] = false
 	}
 
+	S.srej_pending_count = 0
+
 	// We retain the transmit I frame queue so we can continue after establishing a new connection.
 } /* end clear_exception_conditions */
 
@@ -6071,6 +6155,11 @@ func START_T1(S *ax25_dlsm_t) {
 	}
 
 	S.t1_had_expired = false
+
+	S.t1_seq++
+	if S.t1_paused_at.IsZero() {
+		timer_wheel_schedule(S, LINK_TIMER_T1, S.t1_seq, S.t1_exp)
+	}
 } /* end start_t1 */
 
 func STOP_T1(S *ax25_dlsm_t) {
@@ -6101,6 +6190,7 @@ func STOP_T1(S *ax25_dlsm_t) {
 
 	S.t1_exp = time.Time{}   // now stopped.
 	S.t1_had_expired = false // remember that it did not expire.
+	S.t1_seq++               // any wheel entry is now stale.
 } /* end stop_t1 */
 
 func IS_T1_RUNNING(S *ax25_dlsm_t) bool {
@@ -6122,6 +6212,7 @@ func PAUSE_T1(S *ax25_dlsm_t) {
 		var now = time.Now()
 
 		S.t1_paused_at = now
+		S.t1_seq++ // any wheel entry is now stale.
 
 		if s_debug_timers {
 			var pc, _, from_line, _ = runtime.Caller(1)
@@ -6150,6 +6241,9 @@ func RESUME_T1(S *ax25_dlsm_t) {
 		S.t1_exp = S.t1_exp.Add(paused_for)
 		S.t1_paused_at = time.Time{}
 
+		S.t1_seq++
+		timer_wheel_schedule(S, LINK_TIMER_T1, S.t1_seq, S.t1_exp)
+
 		if s_debug_timers {
 			text_color_set(DW_COLOR_DEBUG)
 			dw_printf("Resumed T1 after pausing for %.3f sec, %.3f still remaining, [now=%.3f]\n", paused_for.Seconds(), S.t1_exp.Sub(now).Seconds(), now.Sub(S.start_time).Seconds())
@@ -6175,6 +6269,8 @@ func START_T3(S *ax25_dlsm_t) {
 	}
 
 	S.t3_exp = now.Add(T3_DEFAULT)
+	S.t3_seq++
+	timer_wheel_schedule(S, LINK_TIMER_T3, S.t3_seq, S.t3_exp)
 }
 
 func STOP_T3(S *ax25_dlsm_t) {
@@ -6193,6 +6289,7 @@ func STOP_T3(S *ax25_dlsm_t) {
 	}
 
 	S.t3_exp = time.Time{}
+	S.t3_seq++ // any wheel entry is now stale.
 }
 
 // TM201 is similar to T1.
@@ -6216,6 +6313,11 @@ func START_TM201(S *ax25_dlsm_t) {
 	} else {
 		S.tm201_paused_at = time.Time{}
 	}
+
+	S.tm201_seq++
+	if S.tm201_paused_at.IsZero() {
+		timer_wheel_schedule(S, LINK_TIMER_TM201, S.tm201_seq, S.tm201_exp)
+	}
 } /* end start_tm201 */
 
 func STOP_TM201(S *ax25_dlsm_t) {
@@ -6230,6 +6332,7 @@ func STOP_TM201(S *ax25_dlsm_t) {
 	}
 
 	S.tm201_exp = time.Time{} // now stopped.
+	S.tm201_seq++             // any wheel entry is now stale.
 } /* end stop_tm201 */
 
 func PAUSE_TM201(S *ax25_dlsm_t) {
@@ -6240,6 +6343,7 @@ func PAUSE_TM201(S *ax25_dlsm_t) {
 		var now = time.Now()
 
 		S.tm201_paused_at = now
+		S.tm201_seq++ // any wheel entry is now stale.
 
 		if s_debug_timers {
 			var pc, _, from_line, _ = runtime.Caller(1)
@@ -6268,6 +6372,9 @@ func RESUME_TM201(S *ax25_dlsm_t) {
 		S.tm201_exp = S.tm201_exp.Add(paused_for)
 		S.tm201_paused_at = time.Time{}
 
+		S.tm201_seq++
+		timer_wheel_schedule(S, LINK_TIMER_TM201, S.tm201_seq, S.tm201_exp)
+
 		if s_debug_timers {
 			text_color_set(DW_COLOR_DEBUG)
 			dw_printf("Resumed TM201 after pausing for %.3f sec, %.3f still remaining, [now=%.3f]\n", paused_for.Seconds(), S.tm201_exp.Sub(now).Seconds(), now.Sub(S.start_time).Seconds())
@@ -6276,34 +6383,14 @@ func RESUME_TM201(S *ax25_dlsm_t) {
 } /* end resume_tm201 */
 
 func ax25_link_get_next_timer_expiry() time.Time {
-	var tnext time.Time
-
-	for p := list_head; p != nil; p = p.next {
-		// Consider if running and not paused.
-		if !p.t1_exp.IsZero() && p.t1_paused_at.IsZero() {
-			if tnext.IsZero() {
-				tnext = p.t1_exp
-			} else if p.t1_exp.Before(tnext) {
-				tnext = p.t1_exp
-			}
-		}
-
-		if !p.t3_exp.IsZero() {
-			if tnext.IsZero() {
-				tnext = p.t3_exp
-			} else if p.t3_exp.Before(tnext) {
-				tnext = p.t3_exp
-			}
-		}
-
-		if !p.tm201_exp.IsZero() && p.tm201_paused_at.IsZero() {
-			if tnext.IsZero() {
-				tnext = p.tm201_exp
-			} else if p.tm201_exp.Before(tnext) {
-				tnext = p.tm201_exp
-			}
-		}
-	}
+	// Constant time: the timer wheel maintains the earliest deadline
+	// as timers are scheduled and fired.  This runs for every event
+	// taken off the data link queue so it must stay cheap when many
+	// sessions are connected.  The cached value can be slightly
+	// early if a timer was stopped or paused since it was computed;
+	// that just causes one harmless extra wake up.
+
+	var tnext = timer_wheel_next_expiry()
 
 	if s_debug_timers {
 		text_color_set(DW_COLOR_DEBUG)
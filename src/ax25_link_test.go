@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// Gaps noticed while receiving a multiframe transmission are batched up
+// and sent as one SREJ request after the carrier drops, with anything
+// filled in by a later frame in the same transmission pruned out.
+func TestAX25LinkDeferredSREJBatching(t *testing.T) {
+	var MY_CALL = "Q1TEST"
+	var THEIR_CALL = "Q2TEST"
+	const CHANNEL = 0
+
+	setupTestEnvV22(t) // SREJ requires v2.2
+
+	initiateConnect(t, MY_CALL, THEIR_CALL, CHANNEL)
+
+	var addrs [AX25_MAX_ADDRS]string
+	addrs[OWNCALL] = THEIR_CALL
+	addrs[PEERCALL] = MY_CALL
+	var pp = ax25_u_frame(addrs, 2, cr_res, frame_type_U_UA, 1, 0, nil)
+	receiveFrame(t, pp, CHANNEL)
+
+	var S = list_head
+	assert.Equal(t, state_3_connected, S.state)
+	assert.Equal(t, ax25_modulo_t(128), S.modulo)
+
+	addrs[AX25_DESTINATION] = MY_CALL
+	addrs[AX25_SOURCE] = THEIR_CALL
+
+	// Frame 0 is in sequence and delivered.
+	pp = ax25_i_frame(addrs, 2, cr_cmd, 128, 0, 0, 0, AX25_PID_NO_LAYER_3, []byte("Frame 0"))
+	receiveFrame(t, pp, CHANNEL)
+	assert.Equal(t, 1, S.vr, "V(R) should be 1")
+
+	// Frames 2 and 4 arrive; 1 and 3 are missing.  No SREJ goes out yet;
+	// the gaps are only recorded.
+	pp = ax25_i_frame(addrs, 2, cr_cmd, 128, 0, 2, 0, AX25_PID_NO_LAYER_3, []byte("Frame 2"))
+	receiveFrame(t, pp, CHANNEL)
+	pp = ax25_i_frame(addrs, 2, cr_cmd, 128, 0, 4, 0, AX25_PID_NO_LAYER_3, []byte("Frame 4"))
+	receiveFrame(t, pp, CHANNEL)
+
+	assert.Equal(t, 1, S.vr, "V(R) should still be 1")
+	assert.True(t, S.srej_pending[1], "Should be asking for resend of 1")
+	assert.True(t, S.srej_pending[3], "Should be asking for resend of 3")
+	assert.Equal(t, 2, S.srej_pending_count)
+
+	// Frame 3 shows up later in the same transmission, so its pending
+	// request is dropped.
+	pp = ax25_i_frame(addrs, 2, cr_cmd, 128, 0, 3, 0, AX25_PID_NO_LAYER_3, []byte("Frame 3"))
+	receiveFrame(t, pp, CHANNEL)
+
+	assert.False(t, S.srej_pending[3], "Resend request for 3 should be dropped")
+	assert.Equal(t, 1, S.srej_pending_count)
+
+	// Carrier drop.  The batch goes out and the pending list is cleared.
+	send_pending_srej(S)
+
+	assert.Equal(t, 0, S.srej_pending_count)
+	assert.False(t, S.srej_pending[1])
+	assert.Equal(t, state_3_connected, S.state)
+}
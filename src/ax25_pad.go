@@ -150,6 +150,7 @@ import (
 	"slices"
 	"strconv"
 	"strings"
+	"sync"
 	"time"
 	"unicode"
 )
@@ -241,6 +242,11 @@ type packet_t struct {
 
 	nextp *packet_t /* Pointer to next in queue. */
 
+	decoded *decode_aprs_t /* Memoized result of decode_aprs so several */
+	/* consumers (monitor, filter, mheard, log) of the */
+	/* same received frame share one decode.  Cleared */
+	/* by any function that alters the frame contents. */
+
 	num_addr int /* Number of addresses in frame. */
 	/* Range of AX25_MIN_ADDRS .. AX25_MAX_ADDRS for AX.25. */
 	/* It will be 0 if it doesn't look like AX.25. */
@@ -326,6 +332,21 @@ var ax25_new_count = 0
 var ax25_delete_count = 0
 var last_seq_num int = 0
 
+/*
+ * Packet objects are recycled through a pool.  They are created and
+ * destroyed for every received frame so, at a busy station, allocating
+ * a fresh one each time generates enough garbage collector work to
+ * cause visible timing jitter.  The hit counter lets us verify the
+ * pool is actually effective.
+ */
+
+var ax25_packet_pool sync.Pool
+var ax25_pool_hit_count = 0
+
+func ax25_pool_stats() (int, int) { //nolint:unused // for stats reporting
+	return ax25_pool_hit_count, ax25_new_count
+}
+
 // DECODE_APRS_UTIL is a runtime replacement for DECAMAIN define
 var DECODE_APRS_UTIL = false
 
@@ -374,7 +395,16 @@ func ax25_new() *packet_t {
 		dw_printf("Report to WB2OSZ - Memory leak for packet objects.  new=%d, delete=%d\n", ax25_new_count, ax25_delete_count)
 	}
 
-	var this_p = new(packet_t)
+	var this_p *packet_t
+
+	var recycled = ax25_packet_pool.Get()
+	if recycled == nil {
+		this_p = new(packet_t)
+	} else {
+		ax25_pool_hit_count++
+		this_p = recycled.(*packet_t)
+		*this_p = packet_t{}
+	}
 
 	Assert(this_p != nil)
 
@@ -415,6 +445,8 @@ func AX25Delete(this_p *packet_t) {
 
 	this_p.magic1 = 0
 	this_p.magic2 = 0
+
+	ax25_packet_pool.Put(this_p)
 }
 
 /*------------------------------------------------------------------------------
@@ -1091,6 +1123,8 @@ func ax25_set_addr(this_p *packet_t, n int, ad string) {
 	Assert(this_p.magic2 == MAGIC)
 	Assert(n >= 0 && n < AX25_MAX_ADDRS)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	//dw_printf ("ax25_set_addr (%d, %s) num_addr=%d\n", n, ad, this_p.num_addr);
 
 	if len(ad) == 0 {
@@ -1169,6 +1203,8 @@ func ax25_insert_addr(this_p *packet_t, n int, ad string) {
 	Assert(this_p.magic2 == MAGIC)
 	Assert(n >= AX25_REPEATER_1 && n < AX25_MAX_ADDRS)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	//dw_printf ("ax25_insert_addr (%d, %s)\n", n, ad);
 
 	if len(ad) == 0 {
@@ -1246,6 +1282,8 @@ func ax25_remove_addr(this_p *packet_t, n int) {
 	Assert(this_p.magic2 == MAGIC)
 	Assert(n >= AX25_REPEATER_1 && n < AX25_MAX_ADDRS)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	/* Shift those beyond to fill this position. */
 
 	CLEAR_LAST_ADDR_FLAG(this_p)
@@ -1525,6 +1563,8 @@ func ax25_set_ssid(this_p *packet_t, n int, ssid int) {
 	Assert(this_p.magic1 == MAGIC)
 	Assert(this_p.magic2 == MAGIC)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	if n >= 0 && n < this_p.num_addr {
 		this_p.frame_data[n*7+6] = (this_p.frame_data[n*7+6] & ^(byte(SSID_SSID_MASK))) |
 			byte((ssid<<SSID_SSID_SHIFT)&SSID_SSID_MASK)
@@ -1587,6 +1627,8 @@ func ax25_set_h(this_p *packet_t, n int) {
 	Assert(this_p.magic1 == MAGIC)
 	Assert(this_p.magic2 == MAGIC)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	if n >= 0 && n < this_p.num_addr {
 		this_p.frame_data[n*7+6] |= SSID_H_MASK
 	} else {
@@ -1715,6 +1757,8 @@ func AX25GetInfo(this_p *packet_t) []byte {
 } /* end AX25GetInfo */
 
 func ax25_set_info(this_p *packet_t, new_info []byte) {
+
+	this_p.decoded = nil /* Invalidate memoized decode. */
 	var old_info = AX25GetInfo(this_p)
 	this_p.frame_len -= len(old_info)
 
@@ -1751,6 +1795,8 @@ func ax25_cut_at_crlf(this_p *packet_t) int {
 	Assert(this_p.magic1 == MAGIC)
 	Assert(this_p.magic2 == MAGIC)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	var info = AX25GetInfo(this_p)
 
 	for j, b := range info {
@@ -2565,6 +2611,8 @@ func ax25_set_pid(this_p *packet_t, pid byte) {
 	Assert(this_p.magic1 == MAGIC)
 	Assert(this_p.magic2 == MAGIC)
 
+	this_p.decoded = nil /* Invalidate memoized decode. */
+
 	// Some applications set this to 0 which is an error.
 	// Change 0 to 0xF0 meaning no layer 3 protocol.
 
@@ -0,0 +1,311 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+//nolint:gochecknoglobals
+package direwolf
+
+/*------------------------------------------------------------------
+ *
+ * Purpose:   	Hashed timer wheel for the connected mode link timers.
+ *
+ * Description:	Originally each pass of the recv_process loop scanned
+ *		every data link state machine three times: once to find
+ *		the next T1/T3/TM201 expiration for the queue wait and,
+ *		after a timeout, again to find which timers had fired.
+ *		That cost grows with the number of connected sessions
+ *		and is paid for every received frame, not just when a
+ *		timer goes off.
+ *
+ *		Here running timers are hashed into wheel slots by
+ *		expiration time.  The earliest deadline is cached so
+ *		recv_process gets it in constant time, and firing only
+ *		touches the slots that have come due.  Sessions with no
+ *		running timers have no entries and cost nothing.
+ *
+ *		The t1_exp / t3_exp / tm201_exp fields in ax25_dlsm_t
+ *		remain the source of truth; wheel entries are only
+ *		hints.  Stop and pause do not search the wheel.  They
+ *		just bump the per-timer sequence number and the orphaned
+ *		entry is discarded when its slot is next examined.  An
+ *		entry whose expiration moved later (timer resumed after
+ *		a channel busy pause) is simply rescheduled.
+ *
+ *		Everything here runs in the single recv_process thread,
+ *		like the state machines themselves, so no locking.
+ *
+ *---------------------------------------------------------------*/
+
+import (
+	"time"
+)
+
+// Which of the three link timers a wheel entry refers to.
+
+type link_timer_e int
+
+const (
+	LINK_TIMER_T1 link_timer_e = iota
+	LINK_TIMER_T3
+	LINK_TIMER_TM201
+)
+
+type timer_wheel_entry_t struct {
+	S     *ax25_dlsm_t
+	timer link_timer_e
+	seq   int       // Sequence number at schedule time.  Entry is stale if it no longer matches.
+	exp   time.Time // Expiration at schedule time.
+}
+
+// Number of slots must be a power of two so the hash is a mask.
+// 128 slots of 100 ms give a 12.8 second horizon, enough that T1
+// (seconds) usually lands in a future slot on its first hash.
+// T3 (minutes) wraps around; entries found early are left in place,
+// which costs one look per wrap, every 12.8 seconds at worst.
+
+const TIMER_WHEEL_SLOTS = 128
+const TIMER_WHEEL_SLOT_NS = int64(100 * time.Millisecond)
+
+var timerWheelSlot [TIMER_WHEEL_SLOTS][]timer_wheel_entry_t
+var timerWheelCount int      // Entries in all slots, including stale ones.
+var timerWheelNext time.Time // Earliest expiration of any live entry, zero if none known.
+var timerWheelLast time.Time // Upper bound of the last slot range already fired.
+
+func timer_wheel_slot_for(exp time.Time) int {
+	return int((exp.UnixNano() / TIMER_WHEEL_SLOT_NS) & (TIMER_WHEEL_SLOTS - 1))
+}
+
+/*------------------------------------------------------------------
+*
+* Name:        timer_wheel_schedule
+*
+* Purpose:     Insert a hint that the given timer of the given state
+*		machine expires at the given time.
+*
+* Inputs:	S	- Data Link State Machine.
+*
+*		timer	- LINK_TIMER_T1 / T3 / TM201.
+*
+*		seq	- Current sequence number for that timer.
+*
+*		exp	- Expiration time.  Must not be zero.
+*
+* Description:	Called from the timer start and resume functions in
+*		ax25_link.go.  O(1).
+*
+*----------------------------------------------------------------*/
+
+func timer_wheel_schedule(S *ax25_dlsm_t, timer link_timer_e, seq int, exp time.Time) {
+	var slot = timer_wheel_slot_for(exp)
+
+	timerWheelSlot[slot] = append(timerWheelSlot[slot], timer_wheel_entry_t{S: S, timer: timer, seq: seq, exp: exp})
+	timerWheelCount++
+
+	if timerWheelNext.IsZero() || exp.Before(timerWheelNext) {
+		timerWheelNext = exp
+	}
+}
+
+/*------------------------------------------------------------------
+*
+* Name:        timer_wheel_next_expiry
+*
+* Purpose:     Return the earliest expiration of any scheduled timer,
+*		or zero if none are running.
+*
+* Description:	This is the single deadline handed to
+*		dlq_wait_while_empty by recv_process.  O(1): it is
+*		maintained on insert and after each firing pass.
+*
+*		The cached value can be stale, pointing at a timer
+*		that has since been stopped or paused.  That only
+*		causes an early wake up; timer_wheel_fire discards
+*		the stale entry and computes a fresh deadline.
+*
+*----------------------------------------------------------------*/
+
+func timer_wheel_next_expiry() time.Time {
+	if timerWheelCount == 0 {
+		return time.Time{}
+	}
+
+	return timerWheelNext
+}
+
+// Is this entry still what its sequence number says it is?
+// The state machine could have been removed entirely (magic zeroed
+// by dl_client_cleanup), or the timer stopped, paused or restarted
+// since the entry was inserted.
+
+func timer_wheel_entry_live(e *timer_wheel_entry_t) bool {
+	if e.S.magic1 != MAGIC1 {
+		return false
+	}
+
+	switch e.timer {
+	case LINK_TIMER_T1:
+		return e.seq == e.S.t1_seq && !e.S.t1_exp.IsZero() && e.S.t1_paused_at.IsZero()
+	case LINK_TIMER_T3:
+		return e.seq == e.S.t3_seq && !e.S.t3_exp.IsZero()
+	case LINK_TIMER_TM201:
+		return e.seq == e.S.tm201_seq && !e.S.tm201_exp.IsZero() && e.S.tm201_paused_at.IsZero()
+	}
+
+	return false
+}
+
+// Authoritative expiration time for the timer an entry refers to.
+
+func timer_wheel_entry_exp(e *timer_wheel_entry_t) time.Time {
+	switch e.timer {
+	case LINK_TIMER_T1:
+		return e.S.t1_exp
+	case LINK_TIMER_T3:
+		return e.S.t3_exp
+	case LINK_TIMER_TM201:
+		return e.S.tm201_exp
+	}
+
+	return time.Time{}
+}
+
+/*------------------------------------------------------------------
+*
+* Name:        timer_wheel_fire
+*
+* Purpose:     Collect all timers that have come due and hand each to
+*		the corresponding expiry handler.
+*
+* Description:	Two phases.  First walk only the slots between the
+*		previous firing pass and now, removing entries that are
+*		stale, due, or whose expiration moved later (the last
+*		get rescheduled into their new slot).  Then invoke the
+*		expiry handlers.  The split matters because handlers
+*		start new timers, which append to slots we might
+*		otherwise still be iterating.
+*
+*		Clearing of the timer fields before calling the handler
+*		matches what dl_timer_expiry always did.
+*
+*----------------------------------------------------------------*/
+
+func timer_wheel_fire() {
+	var now = time.Now()
+
+	if timerWheelCount == 0 {
+		timerWheelLast = now
+		return
+	}
+
+	// Which slots to look at.  Never more than one full revolution.
+
+	var first_slot = timer_wheel_slot_for(timerWheelLast)
+	var last_slot = timer_wheel_slot_for(now)
+
+	var nslots = last_slot - first_slot + 1
+	if nslots <= 0 {
+		nslots += TIMER_WHEEL_SLOTS
+	}
+
+	if timerWheelLast.IsZero() || now.Sub(timerWheelLast) >= time.Duration(TIMER_WHEEL_SLOTS*TIMER_WHEEL_SLOT_NS) {
+		nslots = TIMER_WHEEL_SLOTS
+	}
+
+	timerWheelLast = now
+
+	var due []timer_wheel_entry_t
+	var moved []timer_wheel_entry_t
+
+	for k := range nslots {
+		var slot = (first_slot + k) & (TIMER_WHEEL_SLOTS - 1)
+		var keep = timerWheelSlot[slot][:0]
+
+		for _, e := range timerWheelSlot[slot] {
+			if !timer_wheel_entry_live(&e) {
+				timerWheelCount-- // Stale, discard.
+				continue
+			}
+
+			var exp = timer_wheel_entry_exp(&e)
+
+			if !exp.After(now) {
+				due = append(due, e)
+				timerWheelCount--
+
+				continue
+			}
+
+			if !exp.Equal(e.exp) {
+				// Moved later, e.g. resumed after pause.  Rehash
+				// after this loop; inserting now could append to a
+				// slot slice we are still compacting.
+				timerWheelCount--
+				e.exp = exp
+				moved = append(moved, e)
+
+				continue
+			}
+
+			keep = append(keep, e)
+		}
+
+		timerWheelSlot[slot] = keep
+	}
+
+	for i := range moved {
+		timer_wheel_schedule(moved[i].S, moved[i].timer, moved[i].seq, moved[i].exp)
+	}
+
+	for i := range due {
+		var p = due[i].S
+
+		if !timer_wheel_entry_live(&due[i]) {
+			// An earlier handler in this batch stopped it.
+			continue
+		}
+
+		switch due[i].timer {
+		case LINK_TIMER_T1:
+			p.t1_exp = time.Time{}
+			p.t1_paused_at = time.Time{}
+			p.t1_seq++
+			p.t1_had_expired = true
+			t1_expiry(p)
+		case LINK_TIMER_T3:
+			p.t3_exp = time.Time{}
+			p.t3_seq++
+			t3_expiry(p)
+		case LINK_TIMER_TM201:
+			p.tm201_exp = time.Time{}
+			p.tm201_paused_at = time.Time{}
+			p.tm201_seq++
+			tm201_expiry(p)
+		}
+	}
+
+	// Refresh the cached earliest deadline.  This is the only place
+	// that scans, and it only runs when a timeout actually fired.
+
+	timerWheelNext = time.Time{}
+
+	if timerWheelCount > 0 {
+		for slot := range TIMER_WHEEL_SLOTS {
+			var keep = timerWheelSlot[slot][:0]
+
+			for _, e := range timerWheelSlot[slot] {
+				if !timer_wheel_entry_live(&e) {
+					timerWheelCount--
+					continue
+				}
+
+				keep = append(keep, e)
+
+				var exp = timer_wheel_entry_exp(&e)
+				if timerWheelNext.IsZero() || exp.Before(timerWheelNext) {
+					timerWheelNext = exp
+				}
+			}
+
+			timerWheelSlot[slot] = keep
+		}
+	}
+} /* end timer_wheel_fire */
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+/*------------------------------------------------------------------
+ *
+ * Purpose:   	Bounded outbound queue for one attached network client.
+ *
+ * Description:	The AGW (server.go) and KISS TCP (kissnet.go) fan-out
+ *		paths used to write to each client socket directly.  A
+ *		TCP write blocks once the kernel buffer for that client
+ *		fills up, so a single stalled client (sleeping laptop,
+ *		Wi-Fi drop) would back up monitoring for every other
+ *		client and stall the thread doing the fan-out.
+ *
+ *		Now each accepted client gets a clientQueue: a bounded
+ *		channel drained by a dedicated writer goroutine.  The
+ *		fan-out side never blocks.  If the queue is full the
+ *		message is dropped and counted, and a client that stays
+ *		too far behind is evicted so it cannot accumulate drops
+ *		forever.
+ *
+ *		The owner supplies an onDead callback with its own
+ *		cleanup (close socket, clear its table entry, notify the
+ *		data link machinery).  It runs at most once, whether the
+ *		death was a write error, an eviction, or the owner's own
+ *		read side noticing the client went away.
+ *
+ *---------------------------------------------------------------*/
+
+import (
+	"fmt"
+	"net"
+	"sync"
+)
+
+// How many undelivered messages to hold for one client.  At typical
+// monitoring rates this is tens of seconds of traffic.
+
+const CLIENT_QUEUE_DEPTH = 128
+
+// Evict after this many consecutive drops.  Brief stalls ride out in
+// the queue; only a client that keeps not reading gets disconnected.
+
+const CLIENT_QUEUE_EVICT_DROPS = 50
+
+type clientQueue struct {
+	conn  net.Conn
+	queue chan []byte
+	quit  chan struct{}
+
+	onDead func(reason string)
+
+	mu               sync.Mutex
+	dead             bool
+	drops            int // Total messages dropped because the queue was full.
+	consecutiveDrops int // Drops since the last successful enqueue.
+}
+
+// newClientQueue wraps a freshly accepted connection and starts its
+// writer goroutine.  onDead must tolerate being called from either
+// the writer goroutine or whichever thread was enqueueing.
+
+func newClientQueue(conn net.Conn, onDead func(reason string)) *clientQueue {
+	var q = new(clientQueue)
+	q.conn = conn
+	q.queue = make(chan []byte, CLIENT_QUEUE_DEPTH)
+	q.quit = make(chan struct{})
+	q.onDead = onDead
+
+	go q.writer()
+
+	return q
+}
+
+// Send enqueues one message without ever blocking.  Returns false if
+// the message was dropped because the client is not keeping up or is
+// already dead.
+
+func (q *clientQueue) Send(buf []byte) bool {
+	select {
+	case q.queue <- buf:
+		q.mu.Lock()
+		q.consecutiveDrops = 0
+		q.mu.Unlock()
+
+		return true
+	default:
+	}
+
+	q.mu.Lock()
+
+	if q.dead {
+		q.mu.Unlock()
+		return false
+	}
+
+	q.drops++
+	q.consecutiveDrops++
+
+	var evict = q.consecutiveDrops >= CLIENT_QUEUE_EVICT_DROPS
+	var total = q.drops
+
+	q.mu.Unlock()
+
+	if evict {
+		q.Evict(fmt.Sprintf("Client is not reading fast enough; %d undelivered messages dropped.", total))
+	}
+
+	return false
+}
+
+// Evict shuts the queue down and runs the owner's cleanup, exactly
+// once.  Also used by the owner when its read side sees the client
+// disappear, so the writer goroutine does not linger.
+
+func (q *clientQueue) Evict(reason string) {
+	q.mu.Lock()
+
+	if q.dead {
+		q.mu.Unlock()
+		return
+	}
+
+	q.dead = true
+	q.mu.Unlock()
+
+	// Closing the socket unblocks a writer stuck in a slow Write.
+
+	close(q.quit)
+	q.conn.Close()
+
+	if q.onDead != nil {
+		q.onDead(reason)
+	}
+}
+
+func (q *clientQueue) writer() {
+	for {
+		select {
+		case buf := <-q.queue:
+			var _, err = q.conn.Write(buf)
+			if err != nil {
+				q.Evict(fmt.Sprintf("Error sending to client: %s.", err))
+				return
+			}
+		case <-q.quit:
+			return
+		}
+	}
+}
@@ -199,6 +199,10 @@ type misc_config_s struct {
 
 	log_path string /* Either directory or full file name depending on above. */
 
+	metrics_port int /* TCP port for serving runtime metrics over HTTP.  0 = disabled. */
+
+	metrics_time int /* Seconds between metrics dumps to the console.  0 = disabled. */
+
 	dns_sd_enabled bool   /* DNS Service Discovery announcement enabled. */
 	dns_sd_name    string /* Name announced on dns-sd; defaults to "Dire Wolf on <hostname>" */
 
@@ -892,6 +896,8 @@ var configHandlers = map[string]configHandler{
 	"SATGATE":        handleSATGATE,
 	"AGWPORT":        handleAGWPORT,
 	"KISSPORT":       handleKISSPORT,
+	"METRICSPORT":    handleMETRICSPORT,
+	"METRICSTIME":    handleMETRICSTIME,
 	"NULLMODEM":      handleNULLMODEM,
 	"SERIALKISS":     handleNULLMODEM,
 	"SERIALKISSPOLL": handleSERIALKISSPOLL,
@@ -1098,6 +1104,9 @@ func config_init(fname string, p_audio_config *audio_s,
 	p_misc_config.log_daily_names = false
 	p_misc_config.log_path = ""
 
+	p_misc_config.metrics_port = 0
+	p_misc_config.metrics_time = 0
+
 	/* connected mode. */
 
 	p_misc_config.frack = AX25_T1V_FRACK_DEFAULT /* Number of seconds to wait for ack to transmission. */
@@ -5164,6 +5173,72 @@ func handleAGWPORT(ps *parseState) bool {
 	return false
 }
 
+// handleMETRICSPORT handles the METRICSPORT keyword.
+func handleMETRICSPORT(ps *parseState) bool {
+	/*
+	 * METRICSPORT 		- Port number for serving runtime metrics over HTTP.
+	 *			  0 (the default) disables it.
+	 */
+	var t = split("", false)
+	if t == "" {
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("Line %d: Missing port number for METRICSPORT command.\n", ps.line)
+
+		return true
+	}
+	var n, nErr = strconv.Atoi(t)
+	if nErr != nil {
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("Line %d: Invalid port number \"%s\" for METRICSPORT command.\n", ps.line, t)
+
+		return true
+	}
+
+	t = split("", false)
+	if t != "" {
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("Line %d: Unexpected \"%s\" after the port number.\n", ps.line, t)
+
+		return true
+	}
+
+	if (n >= MIN_IP_PORT_NUMBER && n <= MAX_IP_PORT_NUMBER) || n == 0 {
+		ps.misc.metrics_port = n
+	} else {
+		ps.misc.metrics_port = 0
+
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("Line %d: Invalid port number for metrics HTTP server. Metrics server disabled.\n", ps.line)
+	}
+	return false
+}
+
+// handleMETRICSTIME handles the METRICSTIME keyword.
+func handleMETRICSTIME(ps *parseState) bool {
+	/*
+	 * METRICSTIME 		- Number of seconds between runtime metrics
+	 *			  dumps to the console.  0 (the default)
+	 *			  disables them.
+	 */
+	var t = split("", false)
+	if t == "" {
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("Line %d: Missing time value for METRICSTIME command.\n", ps.line)
+
+		return true
+	}
+	var n, nErr = strconv.Atoi(t)
+	if nErr != nil || n < 0 {
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("Line %d: Invalid time value \"%s\" for METRICSTIME command.\n", ps.line, t)
+
+		return true
+	}
+
+	ps.misc.metrics_time = n
+	return false
+}
+
 // handleKISSPORT handles the KISSPORT keyword.
 func handleKISSPORT(ps *parseState) bool {
 	/*
@@ -173,6 +173,12 @@ type decode_aprs_t struct {
 
 	g_comment string /* Comment. */
 
+	g_defer_heavy bool /* Set by decode_aprs_cheap.  Comment processing - */
+	/* frequency, tone, DAO, altitude, base 91 telemetry, */
+	/* and the cleaned up comment text - is postponed */
+	/* until decode_aprs_finish is called. */
+
+	g_deferred_comments [][]byte /* Comment field(s) waiting for decode_aprs_finish. */
 }
 
 /*------------------------------------------------------------------
@@ -203,6 +209,87 @@ type decode_aprs_t struct {
  *------------------------------------------------------------------*/
 
 func decode_aprs(pp *packet_t, quiet bool, third_party_src string) *decode_aprs_t {
+	/*
+	 * A received frame can be examined by several consumers - monitor
+	 * printing, packet filtering, mheard, logging - each of which used
+	 * to repeat the same decode.  The result is memoized on the packet
+	 * object and invalidated if the frame contents are changed.
+	 *
+	 * A memoized result keeps the quiet setting of the first decode.
+	 * On the receive path the full decode happens first, before any
+	 * quiet filter decodes, so error messages are not lost.
+	 */
+	if third_party_src == "" && pp.decoded != nil {
+		decode_aprs_finish(pp.decoded)
+
+		return pp.decoded
+	}
+
+	var A = decode_aprs_internal(pp, quiet, third_party_src, false)
+
+	if third_party_src == "" {
+		pp.decoded = A
+	}
+
+	return A
+}
+
+/*------------------------------------------------------------------
+ *
+ * Function:	decode_aprs_cheap
+ *
+ * Purpose:	Like decode_aprs but skips the heavyweight comment
+ *		processing - frequency, tone, DAO position refinement,
+ *		altitude, base 91 telemetry, comment cleanup.
+ *
+ * Description:	Intended for consumers, such as packet filtering, that
+ *		only look at the packet type, addresses, position, and
+ *		symbol.  Full decoding of every heard packet is expensive
+ *		when a busy channel is being filtered for several clients.
+ *
+ *		Call decode_aprs_finish before using any of the fields
+ *		listed for g_defer_heavy.  Note that g_lat and g_lon
+ *		lack any !DAO! refinement (under 60 feet) until then.
+ *
+ *------------------------------------------------------------------*/
+
+func decode_aprs_cheap(pp *packet_t, quiet bool, third_party_src string) *decode_aprs_t {
+	/* A memoized result, cheap or full, satisfies a cheap request. */
+	if third_party_src == "" && pp.decoded != nil {
+		return pp.decoded
+	}
+
+	var A = decode_aprs_internal(pp, quiet, third_party_src, true)
+
+	if third_party_src == "" {
+		pp.decoded = A
+	}
+
+	return A
+}
+
+/*------------------------------------------------------------------
+ *
+ * Function:	decode_aprs_finish
+ *
+ * Purpose:	Complete a decode started by decode_aprs_cheap.
+ *
+ * Description:	Performs the comment processing that was postponed.
+ *		Safe to call more than once or on a full decode.
+ *
+ *------------------------------------------------------------------*/
+
+func decode_aprs_finish(A *decode_aprs_t) {
+	A.g_defer_heavy = false
+
+	for _, commentData := range A.g_deferred_comments {
+		process_comment(A, commentData)
+	}
+
+	A.g_deferred_comments = nil
+}
+
+func decode_aprs_internal(pp *packet_t, quiet bool, third_party_src string, defer_heavy bool) *decode_aprs_t {
 	//dw_printf ("DEBUG decode_aprs quiet=%d, third_party=%p\n", quiet, third_party_src);
 	var pinfo = AX25GetInfo(pp)
 
@@ -212,6 +299,8 @@ func decode_aprs(pp *packet_t, quiet bool, third_party_src string) *decode_aprs_
 
 	A.g_quiet = quiet
 
+	A.g_defer_heavy = defer_heavy
+
 	A.g_symbol_table = '/' /* Default to primary table. */
 	A.g_symbol_code = ' '  /* What should we have for default symbol? */
 
@@ -308,7 +397,7 @@ func decode_aprs(pp *packet_t, quiet bool, third_party_src string) *decode_aprs_
 		if pp_payload != nil {
 			var payload_src = pinfo[1:]
 			payload_src, _, _ = bytes.Cut(payload_src, []byte{'>'})
-			A = decode_aprs(pp_payload, quiet, string(payload_src)) // 1 means used recursively
+			A = decode_aprs_internal(pp_payload, quiet, string(payload_src), defer_heavy) // 1 means used recursively
 			A.g_has_thirdparty_header = true
 
 			AX25Delete(pp_payload)
@@ -507,7 +596,7 @@ func decode_aprs(pp *packet_t, quiet bool, third_party_src string) *decode_aprs_
 	}
 
 	return A
-} /* end decode_aprs */
+} /* end decode_aprs_internal */
 
 func decode_aprs_print(A *decode_aprs_t) {
 	/*
@@ -1615,6 +1704,8 @@ func aprs_mic_e(A *decode_aprs_t, pp *packet_t, info []byte) {
  *
  *------------------------------------------------------------------*/
 
+var bad_addressee_re = regexp.MustCompile("[A-Z0-9]+ +-[0-9]")
+
 func aprs_message(A *decode_aprs_t, info []byte, quiet bool) {
 	type aprs_message_s struct {
 		DTI       byte /* : */
@@ -1677,8 +1768,6 @@ func aprs_message(A *decode_aprs_t, info []byte, quiet bool) {
 	// cbeacon sendto=r0  delay=0:20  info=":AE7MK -5 :test2"
 	// cbeacon sendto=r0  delay=0:25  info=":AE7   -5 :test3"
 
-	var bad_addressee_re = regexp.MustCompile("[A-Z0-9]+ +-[0-9]")
-
 	if bad_addressee_re.Match(addressee) {
 		text_color_set(DW_COLOR_ERROR)
 		dw_printf("Malformed addressee with space between station name and SSID.\n")
@@ -3974,35 +4063,49 @@ func aprsSign(x float64) float64 {
 	}
 }
 
+/*
+ * Frequency must be at the at the beginning.
+ * Others can be anywhere in the comment.
+ *
+ * Compiled once here rather than on every call because we can see
+ * 30+ packets/sec on a busy channel and compilation is expensive.
+ */
+
+//e = regcomp (&freq_re, "^[0-9A-O][0-9][0-9]\\.[0-9][0-9][0-9 ]MHz( [TCDtcd][0-9][0-9][0-9]| Toff)?( [+-][0-9][0-9][0-9])?");
+
+// Freq optionally preceded by space or /.
+// Third fractional digit can be space instead.
+// "MHz" should be exactly that capitalization.
+// Print warning later it not.
+var std_freq_re = regexp.MustCompile("^[/ ]?([0-9A-O][0-9][0-9]\\.[0-9][0-9][0-9 ])([Mm][Hh][Zz])") /* Frequency in standard format. */
+
+// If no tone, we might gobble up / after any data extension,
+// We could also have a space but it's not required.
+// I don't understand the difference between T and C so treat the same for now.
+// We can also have "off" instead of number to explicitly mean none.
+
+var std_tone_re = regexp.MustCompile("^[/ ]?([TtCc][012][0-9][0-9])")                                                    /* Tone in standard format. */
+var std_toff_re = regexp.MustCompile("^[/ ]?[TtCc][Oo][Ff][Ff]")                                                         /* Explicitly no tone. */
+var std_dcs_re = regexp.MustCompile("^[/ ]?[Dd]([0-7][0-7][0-7])")                                                       /* Digital codes squelch in standard format. */
+var std_offset_re = regexp.MustCompile("^[/ ]?([+-][0-9][0-9][0-9])")                                                    /* Xmit freq offset in standard format. */
+var std_range_re = regexp.MustCompile("^[/ ]?[Rr]([0-9][0-9])([mk])")                                                    /* Range in standard format. */
+var dao_re = regexp.MustCompile("!([A-Z][0-9 ][0-9 ]|[a-z][!-{ ][!-{ ]|T[0-9 B][0-9 ])!")                                /* DAO */
+var alt_re = regexp.MustCompile("/A=[0-9-][0-9][0-9][0-9][0-9][0-9]")                                                    /* /A= altitude */
+var bad_freq_re = regexp.MustCompile("[0-9][0-9][0-9]\\.[0-9][0-9][0-9]?")                                               /* Likely frequency, not standard format */
+var bad_tone_re = regexp.MustCompile("(^|[^0-9.])([6789][0-9]\\.[0-9]|[12][0-9][0-9]\\.[0-9]|67|77|100|123)($|[^0-9.])") /* Likely tone, not standard format */
+var base91_tel_re = regexp.MustCompile("\\|(([!-{][!-{]){2,7})\\|")                                                      /* Base 91 compressed telemetry data. */
+
 func process_comment(A *decode_aprs_t, commentData []byte) {
-	/*
-	 * Frequency must be at the at the beginning.
-	 * Others can be anywhere in the comment.
-	 */
+	if A.g_defer_heavy {
+		/*
+		 * Cheap decode requested.  Postpone all of this work until
+		 * decode_aprs_finish is called, if ever.  Keep our own copy
+		 * because the underlying packet may be recycled first.
+		 */
+		A.g_deferred_comments = append(A.g_deferred_comments, bytes.Clone(commentData))
 
-	//e = regcomp (&freq_re, "^[0-9A-O][0-9][0-9]\\.[0-9][0-9][0-9 ]MHz( [TCDtcd][0-9][0-9][0-9]| Toff)?( [+-][0-9][0-9][0-9])?");
-
-	// Freq optionally preceded by space or /.
-	// Third fractional digit can be space instead.
-	// "MHz" should be exactly that capitalization.
-	// Print warning later it not.
-	var std_freq_re = regexp.MustCompile("^[/ ]?([0-9A-O][0-9][0-9]\\.[0-9][0-9][0-9 ])([Mm][Hh][Zz])") /* Frequency in standard format. */
-
-	// If no tone, we might gobble up / after any data extension,
-	// We could also have a space but it's not required.
-	// I don't understand the difference between T and C so treat the same for now.
-	// We can also have "off" instead of number to explicitly mean none.
-
-	var std_tone_re = regexp.MustCompile("^[/ ]?([TtCc][012][0-9][0-9])")                                                    /* Tone in standard format. */
-	var std_toff_re = regexp.MustCompile("^[/ ]?[TtCc][Oo][Ff][Ff]")                                                         /* Explicitly no tone. */
-	var std_dcs_re = regexp.MustCompile("^[/ ]?[Dd]([0-7][0-7][0-7])")                                                       /* Digital codes squelch in standard format. */
-	var std_offset_re = regexp.MustCompile("^[/ ]?([+-][0-9][0-9][0-9])")                                                    /* Xmit freq offset in standard format. */
-	var std_range_re = regexp.MustCompile("^[/ ]?[Rr]([0-9][0-9])([mk])")                                                    /* Range in standard format. */
-	var dao_re = regexp.MustCompile("!([A-Z][0-9 ][0-9 ]|[a-z][!-{ ][!-{ ]|T[0-9 B][0-9 ])!")                                /* DAO */
-	var alt_re = regexp.MustCompile("/A=[0-9-][0-9][0-9][0-9][0-9][0-9]")                                                    /* /A= altitude */
-	var bad_freq_re = regexp.MustCompile("[0-9][0-9][0-9]\\.[0-9][0-9][0-9]?")                                               /* Likely frequency, not standard format */
-	var bad_tone_re = regexp.MustCompile("(^|[^0-9.])([6789][0-9]\\.[0-9]|[12][0-9][0-9]\\.[0-9]|67|77|100|123)($|[^0-9.])") /* Likely tone, not standard format */
-	var base91_tel_re = regexp.MustCompile("\\|(([!-{][!-{]){2,7})\\|")                                                      /* Base 91 compressed telemetry data. */
+		return
+	}
 
 	commentData = bytes.TrimRight(commentData, "\x00") // Drop any trailing nulls
 	var clen = len(commentData)
@@ -27,8 +27,10 @@ var layer2_tx = []string{"AX.25", "FX.25", "IL2P"} // TODO KG Copied from audio.
 
 var demodulator_state [MAX_RADIO_CHANS][MAX_SUBCHANS]demodulator_state_s
 
-var sample_sum [MAX_RADIO_CHANS][MAX_SUBCHANS]int
-var sample_count [MAX_RADIO_CHANS][MAX_SUBCHANS]int
+/* One anti-alias decimator per channel (the -D option), shared by */
+/* all subchannels.  nil when the channel is not being decimated. */
+
+var channel_decimator [MAX_RADIO_CHANS]*decimator_s
 
 /*------------------------------------------------------------------
  *
@@ -53,6 +55,11 @@ func demod_init(pa *audio_s) int {
 	 */
 	save_audio_config_p = pa
 
+	/* atest calls this once per input file.  Don't keep a decimator */
+	/* from a previous file's configuration. */
+
+	channel_decimator = [MAX_RADIO_CHANS]*decimator_s{}
+
 	for channel := range MAX_RADIO_CHANS {
 		if save_audio_config_p.chan_medium[channel] == MEDIUM_RADIO {
 			/*
@@ -235,6 +242,14 @@ func demod_init(pa *audio_s) int {
 					}
 				}
 
+				/* The rate reduction is done once per channel, ahead of the */
+				/* demodulators, with a proper anti-alias filter.  All the */
+				/* subchannels and slicers are fed from the decimated stream. */
+
+				if save_audio_config_p.achan[channel].decimate > 1 {
+					channel_decimator[channel] = decimator_init(save_audio_config_p.achan[channel].decimate)
+				}
+
 				text_color_set(DW_COLOR_DEBUG)
 				dw_printf("Channel %d: %d baud, AFSK %d & %d Hz, %s, %d sample rate",
 					channel, save_audio_config_p.achan[channel].baud,
@@ -932,18 +947,10 @@ func demod_process_sample(channel int, subchan int, sam int) {
 		// Don't waste CPU time running a demodulator here.
 
 	case MODEM_AFSK, MODEM_EAS:
-		if save_audio_config_p.achan[channel].decimate > 1 {
-			sample_sum[channel][subchan] += sam
-
-			sample_count[channel][subchan]++
-			if sample_count[channel][subchan] >= save_audio_config_p.achan[channel].decimate {
-				demod_afsk_process_sample(channel, subchan, sample_sum[channel][subchan]/save_audio_config_p.achan[channel].decimate, D)
-				sample_sum[channel][subchan] = 0
-				sample_count[channel][subchan] = 0
-			}
-		} else {
-			demod_afsk_process_sample(channel, subchan, sam, D)
-		}
+		/* Rate reduction (the -D option), if enabled, already */
+		/* happened once per channel in multi_modem_process_sample */
+		/* so we just see the decimated stream here. */
+		demod_afsk_process_sample(channel, subchan, sam, D)
 
 	case MODEM_QPSK, MODEM_8PSK, MODEM_BPSK:
 		if save_audio_config_p.achan[channel].decimate > 1 {
@@ -966,6 +973,37 @@ func demod_process_sample(channel int, subchan int, sam int) {
 	} /* switch modem_type */
 } /* end demod_process_sample */
 
+/*-------------------------------------------------------------------
+ *
+ * Name:        demod_process_block
+ *
+ * Purpose:     Process a whole block of audio samples at once.
+ *
+ * Description:	AFSK (without decimation) has a batched FIR path which
+ *		is considerably cheaper than running the filters one
+ *		sample at a time.  Everything else just loops over the
+ *		scalar entry point, so callers holding a block of
+ *		samples don't need to care about the modem type.
+ *
+ *--------------------------------------------------------------------*/
+
+func demod_process_block(channel int, subchan int, sams []int) {
+	Assert(channel >= 0 && channel < MAX_RADIO_CHANS)
+	Assert(subchan >= 0 && subchan < MAX_SUBCHANS)
+
+	if save_audio_config_p.achan[channel].modem_type == MODEM_AFSK &&
+		mute_input[channel] == 0 {
+		var D = &demodulator_state[channel][subchan]
+		demod_afsk_process_block(channel, subchan, sams, D)
+
+		return
+	}
+
+	for _, sam := range sams {
+		demod_process_sample(channel, subchan, sam)
+	}
+} /* end demod_process_block */
+
 /* Doesn't seem right.  Need to revisit this. */
 /* Resulting scale is 0 to almost 100. */
 /* Cranking up the input level produces no more than 97 or 98. */
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+//nolint:gochecknoglobals
+package direwolf
+
+/*------------------------------------------------------------------
+ *
+ * Purpose:   	Shared sample rate decimator ahead of the AFSK
+ *		demodulators.
+ *
+ * Description:	1200 baud AFSK only needs roughly 12 kHz of bandwidth
+ *		but the sound device typically delivers 44100 or 48000
+ *		samples per second.  The "-D" / decimate option reduces
+ *		the rate before demodulation, which greatly reduces CPU
+ *		use with little impact on decoding.
+ *
+ *		Previously the reduction was a simple average of N
+ *		consecutive samples (a boxcar filter, with poor alias
+ *		rejection) and every subchannel repeated it separately.
+ *
+ *		Now a single windowed-sinc lowpass, generated by
+ *		gen_lowpass, runs once per channel at the input rate
+ *		and all subchannels / slicers are fed from the decimated
+ *		stream.  The filter output is only evaluated at the
+ *		decimated rate - the polyphase identity - so the cost
+ *		per input sample is just taps/factor multiplies.
+ *
+ *---------------------------------------------------------------*/
+
+import (
+	"math"
+)
+
+type decimator_s struct {
+	factor int /* Take every Nth sample. */
+	ntaps  int
+	taps   []float64 /* Anti-alias kernel, reversed, so the dot */
+	/* product runs over ascending-time samples. */
+	hist []float64 /* ntaps-1 history samples + factor new ones. */
+	have int       /* New samples accumulated so far, 0 .. factor-1. */
+}
+
+/*
+ * Kernel length is a multiple of the decimation factor so every
+ * polyphase branch has the same number of taps.  8 taps per branch
+ * gives good alias rejection for a fraction of the cost of the
+ * demodulator filters downstream.
+ */
+
+const DECIMATOR_TAPS_PER_PHASE = 8
+
+func decimator_init(factor int) *decimator_s {
+	Assert(factor > 1)
+
+	var dec = new(decimator_s)
+
+	dec.factor = factor
+	dec.ntaps = (DECIMATOR_TAPS_PER_PHASE * factor) | 1
+
+	var kernel = make([]float64, dec.ntaps)
+
+	/* Cutoff a little below the new Nyquist frequency, */
+	/* as a fraction of the original sample rate. */
+
+	gen_lowpass(0.45/float64(factor), kernel, dec.ntaps, BP_WINDOW_HAMMING)
+
+	dec.taps = make([]float64, dec.ntaps)
+	for j := range dec.ntaps {
+		dec.taps[j] = kernel[dec.ntaps-1-j]
+	}
+
+	dec.hist = make([]float64, dec.ntaps-1+factor)
+
+	return dec
+}
+
+/*-------------------------------------------------------------------
+ *
+ * Name:        decimator_sample
+ *
+ * Purpose:     Feed one audio sample in.  Every 'factor' samples, one
+ *		filtered output sample comes out.
+ *
+ * Returns:	Output sample and true, or 0 and false when this input
+ *		did not complete an output interval.
+ *
+ *--------------------------------------------------------------------*/
+
+func decimator_sample(dec *decimator_s, sam int) (int, bool) {
+	dec.hist[dec.ntaps-1+dec.have] = float64(sam)
+
+	dec.have++
+	if dec.have < dec.factor {
+		return 0, false
+	}
+
+	dec.have = 0
+
+	var sum = 0.0
+	for j, t := range dec.taps {
+		sum += t * dec.hist[dec.factor-1+j]
+	}
+
+	copy(dec.hist[:dec.ntaps-1], dec.hist[dec.factor:dec.factor+dec.ntaps-1])
+
+	return int(math.Round(sum)), true
+}
@@ -249,6 +249,9 @@ type demodulator_state_s struct {
 
 			normalize_rpsam float64 // Normalize to -1 to +1 for expected tones.
 
+			blk *afsk_block_state_s // Lazily created by demod_afsk_process_block.
+			// nil when only the per-sample path is used.
+
 		}
 
 		//////////////////////////////////////////////////////////////////////////////////
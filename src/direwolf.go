@@ -787,6 +787,16 @@ x = Silence FX.25 information.`)
 	 */
 
 	packetLogger = NewPacketLogger(misc_config.log_daily_names, misc_config.log_path)
+
+	/*
+	 * Runtime metrics.  The instruments are always collecting; these
+	 * just expose them if the config asked for it.
+	 */
+
+	metrics_register_builtin()
+	metrics_http_init(misc_config.metrics_port)
+	metrics_periodic_start(misc_config.metrics_time)
+
 	beaconService = NewBeaconService(audio_config, misc_config, &igate_config)
 	beaconService.SetDebug(d_t_opt)
 	beaconService.Start()
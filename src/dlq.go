@@ -122,6 +122,7 @@ type dlq_item_t struct {
 
 	status int /* 1 for active or 0 for quiet. */
 
+	enqueued_at time.Time /* When it was appended, for queue wait metrics. */
 }
 
 /* The queue is a linked list of these. */
@@ -142,6 +143,48 @@ var s_delete_count = 0 // TODO:  need to test.
 var s_cdata_new_count = 0    /* To detect memory leak for connected mode data. */
 var s_cdata_delete_count = 0 // TODO:  need to test.
 
+/*
+ * Queue items and connected mode data blocks are recycled through pools
+ * so the steady state receive path does not allocate per frame.  At a
+ * busy igate, a fresh allocation for every received frame adds up to
+ * enough garbage collector work to cause visible timing jitter.
+ * The hit counters let us verify the pools are actually effective.
+ */
+
+var s_item_pool sync.Pool
+var s_item_pool_hits = 0
+
+var s_cdata_pool sync.Pool
+var s_cdata_pool_hits = 0
+
+/* Allocate a queue item, preferably by recycling an old one. */
+
+func dlq_item_new() *dlq_item_t {
+	s_new_count++
+
+	var recycled = s_item_pool.Get()
+	if recycled == nil {
+		return new(dlq_item_t)
+	}
+
+	s_item_pool_hits++
+
+	var pnew = recycled.(*dlq_item_t)
+	*pnew = dlq_item_t{}
+
+	return pnew
+}
+
+/* Pool effectiveness, as (recycled, total) allocation counts. */
+
+func dlq_item_pool_stats() (int, int) { //nolint:unused // for stats reporting
+	return s_item_pool_hits, s_new_count
+}
+
+func cdata_pool_stats() (int, int) { //nolint:unused // for stats reporting
+	return s_cdata_pool_hits, s_cdata_new_count
+}
+
 /*-------------------------------------------------------------------
  *
  * Name:        dlq_init
@@ -182,6 +225,18 @@ func dlq_init() {
 
 	recv_thread_is_waiting = false
 
+	metrics_gauge("dlq_depth", func() int64 {
+		dlq_mutex.Lock()
+		defer dlq_mutex.Unlock()
+
+		var n int64
+		for p := dlq_queue_head; p != nil; p = p.nextp {
+			n++
+		}
+
+		return n
+	})
+
 	was_init = true
 } /* end dlq_init */
 
@@ -253,8 +308,7 @@ func dlq_rec_frame_real(channel int, subchannel int, slice int, pp *packet_t, al
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	if s_new_count > s_delete_count+50 {
 		text_color_set(DW_COLOR_ERROR)
@@ -304,12 +358,17 @@ func dlq_rec_frame(channel int, subchannel int, slice int, pp *packet_t, alevel
  *
  *--------------------------------------------------------------------*/
 
+var dlq_metrics_enqueued = metrics_counter("dlq_enqueued_total")
+var dlq_metrics_wait = metrics_histogram("dlq_wait")
+
 func append_to_queue(pnew *dlq_item_t) {
 	if !was_init {
 		dlq_init()
 	}
 
 	pnew.nextp = nil
+	pnew.enqueued_at = time.Now()
+	dlq_metrics_enqueued.incr()
 
 	/* TODO
 	#if DEBUG1
@@ -441,8 +500,7 @@ func dlq_connect_request(addrs [AX25_MAX_ADDRS]string, num_addr int, channel int
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_CONNECT_REQUEST
 	pnew._chan = channel
@@ -490,8 +548,7 @@ func dlq_disconnect_request(addrs [AX25_MAX_ADDRS]string, num_addr int, channel
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_DISCONNECT_REQUEST
 	pnew._chan = channel
@@ -544,8 +601,7 @@ func dlq_outstanding_frames_request(addrs [AX25_MAX_ADDRS]string, num_addr int,
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_OUTSTANDING_FRAMES_REQUEST
 	pnew._chan = channel
@@ -601,8 +657,7 @@ func dlq_xmit_data_request(addrs [AX25_MAX_ADDRS]string, num_addr int, channel i
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_XMIT_DATA_REQUEST
 	pnew._chan = channel
@@ -656,8 +711,7 @@ func dlq_register_callsign(addr string, channel int, client int) {
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_REGISTER_CALLSIGN
 	pnew._chan = channel
@@ -681,8 +735,7 @@ func dlq_unregister_callsign(addr string, channel int, client int) {
 
 	/* Allocate a new queue item. */
 
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_UNREGISTER_CALLSIGN
 	pnew._chan = channel
@@ -769,8 +822,7 @@ func dlq_seize_confirm(channel int) {
 	*/
 
 	/* Allocate a new queue item. */
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	pnew._type = DLQ_SEIZE_CONFIRM
 	pnew._chan = channel
@@ -808,8 +860,7 @@ func dlq_client_cleanup(client int) {
 	// Assert (client >= 0 && client < MAX_NET_CLIENTS);
 
 	/* Allocate a new queue item. */
-	var pnew = new(dlq_item_t)
-	s_new_count++
+	var pnew = dlq_item_new()
 
 	// All we care about is the client number.
 
@@ -921,6 +972,10 @@ func dlq_remove() *dlq_item_t {
 
 	dlq_mutex.Unlock()
 
+	if result != nil && !result.enqueued_at.IsZero() {
+		dlq_metrics_wait.observe(time.Since(result.enqueued_at))
+	}
+
 	/* TODO KG
 	#if DEBUG
 		text_color_set(DW_COLOR_DEBUG);
@@ -975,6 +1030,8 @@ func dlq_delete(pitem *dlq_item_t) {
 		cdata_delete(pitem.txdata)
 		pitem.txdata = nil
 	}
+
+	s_item_pool.Put(pitem)
 } /* end dlq_delete */
 
 /*-------------------------------------------------------------------
@@ -1004,14 +1061,29 @@ func dlq_delete(pitem *dlq_item_t) {
 func cdata_new(pid int, data []byte) *cdata_t {
 	s_cdata_new_count++
 
-	var cdata = new(cdata_t)
+	var cdata *cdata_t
+
+	var recycled = s_cdata_pool.Get()
+	if recycled == nil {
+		cdata = new(cdata_t)
+	} else {
+		s_cdata_pool_hits++
+		cdata = recycled.(*cdata_t)
+	}
 
 	cdata.magic = TXDATA_MAGIC
 	cdata.next = nil
 	cdata.pid = pid
 	cdata.len = len(data)
 
-	if data != nil {
+	/* Keep a recycled buffer when it is big enough. */
+
+	if data == nil {
+		cdata.data = cdata.data[:0]
+	} else if cap(cdata.data) >= len(data) {
+		cdata.data = cdata.data[:len(data)]
+		copy(cdata.data, data)
+	} else {
 		cdata.data = make([]byte, len(data))
 		copy(cdata.data, data)
 	}
@@ -1047,6 +1119,9 @@ func cdata_delete(cdata *cdata_t) {
 	s_cdata_delete_count++
 
 	cdata.magic = 0
+	cdata.next = nil
+
+	s_cdata_pool.Put(cdata)
 } /* end cdata_delete */
 
 /*-------------------------------------------------------------------
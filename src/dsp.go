@@ -94,6 +94,11 @@ func gen_lowpass(fc float64, lp_filter []float64, filter_size int, wtype bp_wind
 	*/
 	Assert(filter_size >= 3 && filter_size <= MAX_FILTER_SIZE)
 
+	var key = fir_cache_key_t{kind: FIR_CACHE_LOWPASS, p1: fc, size: filter_size, wtype: wtype}
+	if fir_cache_fetch(key, lp_filter[:filter_size]) {
+		return
+	}
+
 	for j := range filter_size {
 		var sinc float64
 
@@ -126,6 +131,8 @@ func gen_lowpass(fc float64, lp_filter []float64, filter_size int, wtype bp_wind
 	for j := range filter_size {
 		lp_filter[j] /= G
 	}
+
+	fir_cache_store(key, lp_filter[:filter_size])
 } /* end gen_lowpass */
 
 // #undef DEBUG1
@@ -164,6 +171,11 @@ func gen_bandpass(f1 float64, f2 float64, bp_filter []float64, filter_size int,
 
 	Assert(filter_size >= 3 && filter_size <= MAX_FILTER_SIZE)
 
+	var key = fir_cache_key_t{kind: FIR_CACHE_BANDPASS, p1: f1, p2: f2, size: filter_size, wtype: wtype}
+	if fir_cache_fetch(key, bp_filter[:filter_size]) {
+		return
+	}
+
 	for j := range filter_size {
 		var sinc float64
 
@@ -205,6 +217,8 @@ func gen_bandpass(f1 float64, f2 float64, bp_filter []float64, filter_size int,
 	for j := range filter_size {
 		bp_filter[j] /= G
 	}
+
+	fir_cache_store(key, bp_filter[:filter_size])
 } /* end gen_bandpass */
 
 /*------------------------------------------------------------------
@@ -324,6 +338,11 @@ func rrc(t float64, a float64) float64 {
 // The Root Raised Cosine (RRC) low pass filter is suppposed to minimize Intersymbol Interference (ISI).
 
 func gen_rrc_lowpass(pfilter []float64, filter_taps int, rolloff float64, samples_per_symbol float64) {
+	var key = fir_cache_key_t{kind: FIR_CACHE_RRC, p1: rolloff, p2: samples_per_symbol, size: filter_taps}
+	if fir_cache_fetch(key, pfilter[:filter_taps]) {
+		return
+	}
+
 	var t float64
 
 	for k := range filter_taps {
@@ -341,6 +360,8 @@ func gen_rrc_lowpass(pfilter []float64, filter_taps int, rolloff float64, sample
 	for k := range filter_taps {
 		pfilter[k] /= t
 	}
+
+	fir_cache_store(key, pfilter[:filter_taps])
 }
 
 /* end dsp.c */
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+/*------------------------------------------------------------------
+ *
+ * Purpose:     Memoize the FIR filter kernels produced by dsp.go.
+ *
+ * Description:	A receive channel with multiple slicers / subchannels
+ *		creates many demodulator instances, and most of them
+ *		ask for exactly the same filter: same cutoff, same tap
+ *		count, same window.  The windowed-sinc generation is
+ *		pure - the taps are completely determined by the
+ *		parameters - so we compute each distinct kernel once
+ *		and hand out copies after that.
+ *
+ *		Everything lives in memory.  The tables are cheap
+ *		enough to regenerate that persisting them to disk
+ *		would only buy us stale-cache problems.
+ *
+ *----------------------------------------------------------------*/
+
+import (
+	"sync"
+)
+
+// Which generator produced the kernel.  The parameter fields mean
+// different things for each, so kernels from different generators can
+// never collide even if the numbers happen to match.
+
+type fir_cache_kind_t int
+
+const (
+	FIR_CACHE_LOWPASS fir_cache_kind_t = iota
+	FIR_CACHE_BANDPASS
+	FIR_CACHE_RRC
+)
+
+type fir_cache_key_t struct {
+	kind  fir_cache_kind_t
+	p1    float64     // fc for lowpass, f1 for bandpass, rolloff for RRC.
+	p2    float64     // f2 for bandpass, samples per symbol for RRC.
+	size  int         // Number of filter taps.
+	wtype bp_window_t // Window type.  Unused (zero) for RRC.
+}
+
+var fir_cache = make(map[fir_cache_key_t][]float64) //nolint:gochecknoglobals
+var fir_cache_mutex sync.Mutex                      //nolint:gochecknoglobals
+
+var fir_cache_hits int   //nolint:gochecknoglobals
+var fir_cache_misses int //nolint:gochecknoglobals
+
+/*------------------------------------------------------------------
+ *
+ * Name:        fir_cache_fetch
+ *
+ * Purpose:     Copy a previously generated kernel into the caller's
+ *		filter array, if we have one.
+ *
+ * Inputs:	key		- Generator and its parameters.
+ *
+ * Outputs:	taps		- Filled in on a hit.
+ *
+ * Returns:	true on a hit, false if the caller must generate.
+ *
+ *----------------------------------------------------------------*/
+
+func fir_cache_fetch(key fir_cache_key_t, taps []float64) bool {
+	fir_cache_mutex.Lock()
+	defer fir_cache_mutex.Unlock()
+
+	var cached, ok = fir_cache[key]
+	if !ok {
+		fir_cache_misses++
+		return false
+	}
+
+	fir_cache_hits++
+	copy(taps, cached)
+	return true
+} /* end fir_cache_fetch */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        fir_cache_store
+ *
+ * Purpose:     Remember a freshly generated kernel.
+ *
+ * Inputs:	key		- Generator and its parameters.
+ *		taps		- The generated kernel.  A private copy
+ *				  is kept; the caller's array may be
+ *				  modified freely afterwards.
+ *
+ *----------------------------------------------------------------*/
+
+func fir_cache_store(key fir_cache_key_t, taps []float64) {
+	fir_cache_mutex.Lock()
+	defer fir_cache_mutex.Unlock()
+
+	var cached = make([]float64, len(taps))
+	copy(cached, taps)
+	fir_cache[key] = cached
+} /* end fir_cache_store */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        fir_cache_stats
+ *
+ * Purpose:     Report cache effectiveness.
+ *
+ * Outputs:	hits, misses	- Lookup counts since startup.
+ *
+ *----------------------------------------------------------------*/
+
+func fir_cache_stats() (hits int, misses int) {
+	fir_cache_mutex.Lock()
+	defer fir_cache_mutex.Unlock()
+
+	return fir_cache_hits, fir_cache_misses
+} /* end fir_cache_stats */
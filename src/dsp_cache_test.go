@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"testing"
+)
+
+// A cached kernel must be byte-for-byte what the generator would have
+// produced, and repeating a request must actually hit the cache.
+
+func TestFirCacheRepeatsAreIdentical(t *testing.T) {
+	var first [MAX_FILTER_SIZE]float64
+	var second [MAX_FILTER_SIZE]float64
+
+	var check = func(name string, size int, gen func(taps []float64)) {
+		t.Helper()
+
+		gen(first[:])
+
+		var hitsBefore, _ = fir_cache_stats()
+		gen(second[:])
+		var hitsAfter, _ = fir_cache_stats()
+
+		if hitsAfter <= hitsBefore {
+			t.Errorf("%s: second generation did not hit the cache", name)
+		}
+
+		for j := range size {
+			if first[j] != second[j] {
+				t.Errorf("%s: tap %d differs: %g vs %g", name, j, first[j], second[j])
+				break
+			}
+		}
+	}
+
+	check("lowpass", 99, func(taps []float64) {
+		gen_lowpass(0.0311, taps, 99, BP_WINDOW_TRUNCATED)
+	})
+
+	check("bandpass", 121, func(taps []float64) {
+		gen_bandpass(0.0227, 0.0499, taps, 121, BP_WINDOW_HAMMING)
+	})
+
+	check("rrc", 81, func(taps []float64) {
+		gen_rrc_lowpass(taps, 81, 0.35, 4.5882)
+	})
+}
@@ -20,6 +20,12 @@ type rs_t struct {
 	fcr      byte   /* First consecutive root, index form */
 	prim     byte   /* Primitive element, index form */
 	iprim    byte   /* prim-th root of 1, index form */
+
+	/* Encoder acceleration table, (nn+1) rows of nroots bytes. */
+	/* Row v holds the parity contributions for feedback byte v */
+	/* so the encoder inner loop is a plain XOR instead of */
+	/* log/antilog lookups per parity symbol.  See init_rs_char. */
+	enc_rows []byte
 }
 
 func modnn(rs *rs_t, _x int) int {
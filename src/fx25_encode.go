@@ -33,7 +33,58 @@ package direwolf
  *
  */
 
+import "encoding/binary"
+
+/*
+ * Table-driven encoder.  Used for all outgoing FX.25 and IL2P frames.
+ *
+ * The classic Karn encoder below does a log lookup, a modnn and an
+ * antilog lookup per parity symbol per data byte.  Here all of that
+ * is folded into rs.enc_rows at init time (see init_rs_char), so each
+ * data byte costs one row lookup and nroots XORs, done eight bytes at
+ * a time where the register is long enough.  A zero feedback term,
+ * common with IL2P's zero padded blocks, is just the shift.
+ */
+
 func encode_rs_char(rs *rs_t, data []byte, bb []byte) {
+	var nroots = int(rs.nroots)
+	var dataLen = int(rs.nn) - nroots
+
+	// Clear out the FEC data area
+	for k := range bb {
+		bb[k] = 0
+	}
+
+	for i := range dataLen {
+		var feedback = int(data[i] ^ bb[0])
+
+		// Shift
+		copy(bb, bb[1:])
+		bb[nroots-1] = 0
+
+		if feedback == 0 {
+			continue
+		}
+
+		var row = rs.enc_rows[feedback*nroots : (feedback+1)*nroots]
+
+		var j = 0
+		for ; j+8 <= nroots; j += 8 {
+			binary.LittleEndian.PutUint64(bb[j:], binary.LittleEndian.Uint64(bb[j:])^binary.LittleEndian.Uint64(row[j:]))
+		}
+
+		for ; j < nroots; j++ {
+			bb[j] ^= row[j]
+		}
+	}
+}
+
+/*
+ * Original byte-by-byte encoder, kept as the reference that the
+ * table-driven version is tested against.
+ */
+
+func encode_rs_char_reference(rs *rs_t, data []byte, bb []byte) {
 	var nroots = int(rs.nroots)
 	var nn = int(rs.nn)
 	var dataLen = nn - nroots
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"bytes"
+	"testing"
+)
+
+// The table-driven encoder must produce the same parity as the
+// reference byte-by-byte encoder for every codec we actually use:
+// the three FX.25 polynomials (fcr=1) and the five IL2P parity
+// sizes (fcr=0).
+
+func TestEncodeRSCharMatchesReference(t *testing.T) {
+	var configs = []struct {
+		name   string
+		fcr    uint
+		nroots uint
+	}{
+		{"FX.25 RS(255,239)", 1, 16},
+		{"FX.25 RS(255,223)", 1, 32},
+		{"FX.25 RS(255,191)", 1, 64},
+		{"IL2P 2 parity", 0, 2},
+		{"IL2P 4 parity", 0, 4},
+		{"IL2P 6 parity", 0, 6},
+		{"IL2P 8 parity", 0, 8},
+		{"IL2P 16 parity", 0, 16},
+	}
+
+	for _, config := range configs {
+		t.Run(config.name, func(t *testing.T) {
+			var rs = init_rs_char(8, 0x11d, config.fcr, 1, config.nroots)
+			if rs == nil {
+				t.Fatal("init_rs_char failed")
+			}
+
+			var dataLen = int(rs.nn) - int(rs.nroots)
+
+			var r = bench_rand_t{state: bench_seed}
+
+			for trial := range 20 {
+				var data = make([]byte, dataLen)
+
+				switch trial {
+				case 0:
+					// All zero, the IL2P padding case.
+				case 1:
+					for i := range data {
+						data[i] = 0xFF
+					}
+				default:
+					for i := range data {
+						data[i] = byte(r.next())
+					}
+				}
+
+				var want = make([]byte, rs.nroots)
+				encode_rs_char_reference(rs, data, want)
+
+				var got = make([]byte, rs.nroots)
+				encode_rs_char(rs, data, got)
+
+				if !bytes.Equal(got, want) {
+					t.Errorf("trial %d: parity mismatch\n got %v\nwant %v", trial, got, want)
+				}
+			}
+		})
+	}
+}
+
+// Round trip through the real decoder, to catch any case where both
+// encoders could agree with each other but not with the decoder.
+
+func TestEncodeRSCharDecodes(t *testing.T) {
+	FX25Init(0)
+
+	var rs = fx25_get_rs(CTAG_MIN)
+	var nroots = fx25_get_nroots(CTAG_MIN)
+
+	var r = bench_rand_t{state: bench_seed}
+
+	var codeword = make([]byte, FX25_BLOCK_SIZE)
+	for i := range FX25_BLOCK_SIZE - nroots {
+		codeword[i] = byte(r.next())
+	}
+
+	encode_rs_char(rs, codeword[:FX25_BLOCK_SIZE-nroots], codeword[FX25_BLOCK_SIZE-nroots:])
+
+	var derrors = decode_rs_char(rs, codeword, nil, 0)
+	if derrors != 0 {
+		t.Errorf("decode of freshly encoded codeword reported %d errors", derrors)
+	}
+}
@@ -52,6 +52,38 @@ package direwolf
 // #define DEBUG 5
 
 func decode_rs_char(rs *rs_t, data []byte, eras_pos []int, no_eras int) int {
+	var nn = int(rs.nn)
+	var nroots = int(rs.nroots)
+	var fcr = int(rs.fcr)
+	var prim = int(rs.prim)
+
+	var s = make([]byte, FX25_MAX_CHECK)
+
+	// form the syndromes; i.e., evaluate data(x) at roots of g(x)
+	for i := 0; i < nroots; i++ {
+		s[i] = data[0]
+	}
+
+	for j := 1; j < nn; j++ {
+		for i := range nroots {
+			if s[i] == 0 {
+				s[i] = data[j]
+			} else {
+				s[i] = data[j] ^ rs.alpha_to[modnn(rs, int(rs.index_of[s[i]])+(fcr+i)*prim)]
+			}
+		}
+	}
+
+	return decode_rs_char_syndromes(rs, data, s, eras_pos, no_eras)
+}
+
+// Same as decode_rs_char but the caller supplies the syndromes (polynomial
+// form), typically accumulated incrementally while the codeword was still
+// being received.  That skips the most expensive part of the decode - the
+// O(nn * nroots) syndrome pass over the whole block - at end of frame.
+// The syn slice is not modified.
+
+func decode_rs_char_syndromes(rs *rs_t, data []byte, syn []byte, eras_pos []int, no_eras int) int {
 	// Access rs struct members
 	var nn = int(rs.nn)
 	var nroots = int(rs.nroots)
@@ -77,20 +109,7 @@ func decode_rs_char(rs *rs_t, data []byte, eras_pos []int, no_eras int) int {
 	var synError int
 	var count int
 
-	// form the syndromes; i.e., evaluate data(x) at roots of g(x)
-	for i = 0; i < nroots; i++ {
-		s[i] = data[0]
-	}
-
-	for j = 1; j < nn; j++ {
-		for i = range nroots {
-			if s[i] == 0 {
-				s[i] = data[j]
-			} else {
-				s[i] = data[j] ^ rs.alpha_to[modnn(rs, int(rs.index_of[s[i]])+(fcr+i)*prim)]
-			}
-		}
-	}
+	copy(s, syn[:nroots])
 
 	// Convert syndromes to index form, checking for nonzero condition
 	synError = 0
@@ -429,6 +429,30 @@ func init_rs_char(symsize uint, gfpoly uint, fcr uint, prim uint, nroots uint) *
 		rs.genpoly[i] = rs.index_of[rs.genpoly[i]]
 	}
 
+	// Precompute the encoder acceleration table.  For each possible
+	// feedback byte value v, row v holds the nroots values that get
+	// XORed into the parity register after its one byte shift:
+	//
+	//	row[p] = alpha_to[modnn(index_of[v] + genpoly[nroots-1-p])]
+	//
+	// with the last entry using genpoly[0].  Row 0 stays all zero
+	// because a zero feedback term contributes nothing.  This turns
+	// the encoder inner loop into table row lookup plus XOR.
+	// Memory cost is (nn+1) * nroots bytes, at most 16 KiB here.
+
+	rs.enc_rows = make([]byte, (int(rs.nn)+1)*int(nroots))
+
+	for v := 1; v <= int(rs.nn); v++ {
+		var row = rs.enc_rows[v*int(nroots) : (v+1)*int(nroots)]
+		var idx = int(rs.index_of[v])
+
+		for p := 0; p < int(nroots)-1; p++ {
+			row[p] = rs.alpha_to[modnn(rs, idx+int(rs.genpoly[int(nroots)-1-p]))]
+		}
+
+		row[nroots-1] = rs.alpha_to[modnn(rs, idx+int(rs.genpoly[0]))]
+	}
+
 	return rs
 }
 
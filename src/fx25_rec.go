@@ -26,10 +26,13 @@ type fx_context_s struct {
 	k_data_radio int    // Expected size of "data" sent over radio.
 	coffs        int    // Starting offset of the check part.
 	nroots       int    // Expected number of check bytes.
+	rs           *rs_t  // RS codec for the matched tag.
 	dlen         int    // Accumulated length in "data" below.
 	clen         int    // Accumulated length in "check" below.
 	imask        byte   // Mask for storing a bit.
 	block        [FX25_BLOCK_SIZE + 1]byte
+	syn          [FX25_MAX_CHECK]byte // RS syndromes, accumulated as each byte completes
+	// so the end-of-block decode decision is nearly free.
 }
 
 var fx_context [MAX_RADIO_CHANS][MAX_SUBCHANS][MAX_SLICERS]*fx_context_s
@@ -107,6 +110,8 @@ func FX25RecBit(channel int, subchannel int, slice int, dbit int) {
 			F.clen = 0
 			F.block = [FX25_BLOCK_SIZE + 1]byte{}
 			F.block[FX25_BLOCK_SIZE] = FENCE
+			F.syn = [FX25_MAX_CHECK]byte{}
+			F.rs = fx25_get_rs(F.ctag_num)
 			F.state = FX_DATA
 		}
 
@@ -119,8 +124,15 @@ func FX25RecBit(channel int, subchannel int, slice int, dbit int) {
 		if F.imask == 0 {
 			F.imask = 0x01
 
+			fx25_syndrome_byte(F, F.block[F.dlen])
+
 			F.dlen++
 			if F.dlen >= F.k_data_radio {
+				// Anything between the data and check parts is zero fill
+				// which the sender never transmits.  Account for it in the
+				// syndromes now, with a single exponent step per root.
+				fx25_syndrome_zero_fill(F, F.coffs-F.k_data_radio)
+
 				F.state = FX_CHECK
 			}
 		}
@@ -134,6 +146,8 @@ func FX25RecBit(channel int, subchannel int, slice int, dbit int) {
 		if F.imask == 0 {
 			F.imask = 0x01
 
+			fx25_syndrome_byte(F, F.block[F.coffs+F.clen])
+
 			F.clen++
 			if F.clen >= F.nroots {
 				process_rs_block(channel, subchannel, slice, F) // see below
@@ -146,6 +160,60 @@ func FX25RecBit(channel int, subchannel int, slice int, dbit int) {
 	}
 }
 
+/***********************************************************************************
+ *
+ * Name:        fx25_syndrome_byte
+ *
+ * Purpose:     Fold one completed codeword byte into the running RS syndromes.
+ *
+ * Description:	This is the same Horner evaluation of the received polynomial
+ *		at the generator roots that decode_rs_char performs, just spread
+ *		out over the reception of the block instead of done in one burst
+ *		at the end.  By the time the last check byte arrives, deciding
+ *		whether the codeword needs any correction at all is a simple
+ *		test for all-zero syndromes.
+ *
+ ***********************************************************************************/
+
+func fx25_syndrome_byte(F *fx_context_s, b byte) {
+	var rs = F.rs
+	var fcr = int(rs.fcr)
+	var prim = int(rs.prim)
+
+	for i := range F.nroots {
+		if F.syn[i] == 0 {
+			F.syn[i] = b
+		} else {
+			F.syn[i] = b ^ rs.alpha_to[modnn(rs, int(rs.index_of[F.syn[i]])+(fcr+i)*prim)]
+		}
+	}
+}
+
+/***********************************************************************************
+ *
+ * Name:        fx25_syndrome_zero_fill
+ *
+ * Purpose:     Advance the running RS syndromes past nzero zero-valued bytes.
+ *
+ * Description:	Shortened codes leave a gap of zero bytes between the data and
+ *		check parts of the RS block.  Feeding a zero byte through the
+ *		Horner step just multiplies each syndrome by its root, so a run
+ *		of them collapses into one exponent addition per root.
+ *
+ ***********************************************************************************/
+
+func fx25_syndrome_zero_fill(F *fx_context_s, nzero int) {
+	var rs = F.rs
+	var fcr = int(rs.fcr)
+	var prim = int(rs.prim)
+
+	for i := range F.nroots {
+		if F.syn[i] != 0 {
+			F.syn[i] = rs.alpha_to[modnn(rs, int(rs.index_of[F.syn[i]])+nzero*(fcr+i)*prim)]
+		}
+	}
+}
+
 /***********************************************************************************
  *
  * Name:        fx25_rec_busy
@@ -229,7 +297,20 @@ func process_rs_block(channel int, subchannel int, slice int, F *fx_context_s) {
 	var derrlocs [FX25_MAX_CHECK]int // Half would probably be OK.
 	var rs = fx25_get_rs(F.ctag_num)
 
-	var derrors = decode_rs_char(rs, F.block[:FX25_BLOCK_SIZE], derrlocs[:], 0)
+	// The syndromes were accumulated while the block was being received.
+	// All zero means the block is already a valid codeword and the decode
+	// decision costs nothing.  Otherwise hand the syndromes to the decoder
+	// so it can go straight to finding the error locations.
+
+	var synError byte = 0
+	for i := range F.nroots {
+		synError |= F.syn[i]
+	}
+
+	var derrors = 0
+	if synError != 0 {
+		derrors = decode_rs_char_syndromes(rs, F.block[:FX25_BLOCK_SIZE], F.syn[:F.nroots], derrlocs[:], 0)
+	}
 
 	if derrors >= 0 { // -1 for failure.  >= 0 for success, number of bytes corrected.
 		if fx25_get_debug() >= 2 {
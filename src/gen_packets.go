@@ -52,6 +52,7 @@ package direwolf
 
 import (
 	"bufio"
+	"bytes"
 	"encoding/binary"
 	"fmt"
 	"io"
@@ -158,6 +159,8 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 	var il2pNormal = pflag.IntP("il2p", "I", -1, "Enable IL2P transmit.  n=1 is recommended.  0 uses weaker FEC.")
 	var il2pInverted = pflag.IntP("il2p-inverted", "i", -1, "Enable IL2P transmit, inverted polarity.  n=1 is recommended.  0 uses weaker FEC.")
 	var variableSpeedStr = pflag.StringP("variable-speed", "v", "", "max[,incr] Variable speed with specified maximum error and increment.")
+	var noiseSweep = pflag.IntP("noise-sweep", "w", 0, "Generate this many .wav files, each with every packet at one constant noise level.  The clean signal is rendered once and the variants are written by parallel workers.  -o is used as a name template.")
+	var sweepWorkers = pflag.IntP("parallel", "p", 0, "Number of parallel workers for --noise-sweep.  Default is one per CPU.")
 	var help = pflag.BoolP("help", "h", false, "Display help text.")
 
 	pflag.Usage = func() {
@@ -223,6 +226,20 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 		g_add_noise = false
 	}
 
+	if *noiseSweep > 0 {
+		if g_add_noise {
+			text_color_set(DW_COLOR_ERROR)
+			fmt.Printf("Can't combine -n with --noise-sweep.  The sweep supplies the noise.\n")
+			os.Exit(1)
+		}
+
+		if *eightBitsPerSample {
+			text_color_set(DW_COLOR_ERROR)
+			fmt.Printf("Noise sweep requires 16 bit samples.\n")
+			os.Exit(1)
+		}
+	}
+
 	if *audioSampleRate != DEFAULT_SAMPLES_PER_SEC {
 		modem.adev[0].samples_per_sec = *audioSampleRate
 
@@ -490,12 +507,22 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 		os.Exit(1)
 	}
 
-	var err = audio_file_open(*outputFile, &modem)
+	var sweep_capture *bytes.Buffer
 
-	if err < 0 {
-		text_color_set(DW_COLOR_ERROR)
-		fmt.Printf("ERROR - Can't open output file.\n")
-		os.Exit(1)
+	if *noiseSweep > 0 {
+		// Render the clean signal once, into memory.  The sweep workers
+		// reuse it for every noise level instead of re-synthesizing.
+		sweep_capture = new(bytes.Buffer)
+		genPacketsOutBuf = bufio.NewWriter(sweep_capture)
+		byte_count = 0
+	} else {
+		var err = audio_file_open(*outputFile, &modem)
+
+		if err < 0 {
+			text_color_set(DW_COLOR_ERROR)
+			fmt.Printf("ERROR - Can't open output file.\n")
+			os.Exit(1)
+		}
 	}
 
 	gen_tone_init(&modem, *amplitude/2, true)
@@ -563,7 +590,7 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 			send_packet(str)
 		}
 
-		audio_file_close()
+		gen_packets_finish(sweep_capture, *outputFile, *noiseSweep, *sweepWorkers, *amplitude)
 
 		return
 	}
@@ -600,24 +627,7 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 		 * for now just use a random number generator.
 		 */
 		for i := 1; i <= packet_count; i++ {
-			if modem.achan[0].baud < 600 {
-				/* e.g. 300 bps AFSK - About 2/3 should be decoded properly. */
-				g_noise_level = float64(*amplitude) * .0048 * (float64(i) / float64(packet_count))
-			} else if modem.achan[0].baud < 1800 {
-				/* e.g. 1200 bps AFSK - About 2/3 should be decoded properly. */
-				g_noise_level = float64(*amplitude) * .0023 * (float64(i) / float64(packet_count))
-			} else if modem.achan[0].baud < 3600 {
-				/* e.g. 2400 bps QPSK - T.B.D. */
-				g_noise_level = float64(*amplitude) * .0015 * (float64(i) / float64(packet_count))
-			} else if modem.achan[0].baud < 7200 {
-				/* e.g. 4800 bps - T.B.D. */
-				g_noise_level = float64(*amplitude) * .0007 * (float64(i) / float64(packet_count))
-			} else {
-				/* e.g. 9600 */
-				g_noise_level = 0.33 * (float64(*amplitude) / 200.0) * (float64(i) / float64(packet_count))
-				// temp test
-				// g_noise_level = 0.20 * (amplitude / 200.0) * (float64(i) / float64(packet_count));
-			}
+			g_noise_level = gen_packets_noise_level(modem.achan[0].baud, *amplitude, float64(i)/float64(packet_count))
 
 			var stemp = fmt.Sprintf("WB2OSZ-15>TEST:,The quick brown fox jumps over the lazy dog!  %04d of %04d", i, packet_count)
 			send_packet(stemp)
@@ -640,7 +650,33 @@ EAS for Emergency Alert System (EAS) Specific Area Message Encoding (SAME).`)
 		}
 	}
 
-	audio_file_close()
+	gen_packets_finish(sweep_capture, *outputFile, *noiseSweep, *sweepWorkers, *amplitude)
+}
+
+/*------------------------------------------------------------------
+ *
+ * Name:        gen_packets_finish
+ *
+ * Purpose:     Complete the output, for either a single file or a
+ *		noise sweep corpus.
+ *
+ *----------------------------------------------------------------*/
+
+func gen_packets_finish(sweep_capture *bytes.Buffer, template string, count int, nworkers int, amplitude int) {
+	if sweep_capture == nil {
+		audio_file_close()
+
+		return
+	}
+
+	var flushErr = genPacketsOutBuf.Flush()
+	if flushErr != nil {
+		text_color_set(DW_COLOR_ERROR)
+		fmt.Printf("Couldn't capture clean signal: %s\n", flushErr)
+		os.Exit(1)
+	}
+
+	os.Exit(gen_packets_sweep(sweep_capture.Bytes(), template, count, nworkers, amplitude, &modem))
 }
 
 /*------------------------------------------------------------------
@@ -893,6 +929,45 @@ func send_packet(str string) {
 	}
 }
 
+/*------------------------------------------------------------------
+ *
+ * Name:        gen_packets_noise_level
+ *
+ * Purpose:     Noise amplitude for a given fraction of the maximum.
+ *
+ * Inputs:	baud		- Data rate, which determines how much
+ *				  noise a modem can be expected to tolerate.
+ *
+ *		amplitude	- Signal amplitude, percent, from -a option.
+ *
+ *		ratio		- 0 to 1, position within the ramp or sweep.
+ *
+ * Description:	Used for both the -n increasing noise ramp within one
+ *		file and the --noise-sweep corpus where each file gets
+ *		one constant level.  At ratio 1 roughly 2/3 of the
+ *		frames should be decoded properly.
+ *
+ *----------------------------------------------------------------*/
+
+func gen_packets_noise_level(baud int, amplitude int, ratio float64) float64 {
+	if baud < 600 {
+		/* e.g. 300 bps AFSK */
+		return float64(amplitude) * .0048 * ratio
+	} else if baud < 1800 {
+		/* e.g. 1200 bps AFSK */
+		return float64(amplitude) * .0023 * ratio
+	} else if baud < 3600 {
+		/* e.g. 2400 bps QPSK - T.B.D. */
+		return float64(amplitude) * .0015 * ratio
+	} else if baud < 7200 {
+		/* e.g. 4800 bps - T.B.D. */
+		return float64(amplitude) * .0007 * ratio
+	}
+
+	/* e.g. 9600 */
+	return 0.33 * (float64(amplitude) / 200.0) * ratio
+} /* end gen_packets_noise_level */
+
 /*------------------------------------------------------------------
  *
  * Name:        audio_put
@@ -965,6 +1040,37 @@ func audio_put(a int, c uint8) int { //nolint:unparam
 	}
 }
 
+func audio_put_block_fake(a int, block []byte) int {
+	if g_add_noise {
+		// Noise insertion works on 16 bit sample boundaries,
+		// so feed it a byte at a time.
+		for _, c := range block {
+			if audio_put_fake(a, c) < 0 {
+				return -1
+			}
+		}
+
+		return len(block)
+	}
+
+	byte_count += len(block)
+
+	var n, writeErr = genPacketsOutBuf.Write(block)
+	if writeErr != nil {
+		return -1
+	}
+
+	return n
+}
+
+func audio_put_block(a int, block []byte) int {
+	if GEN_PACKETS {
+		return audio_put_block_fake(a, block)
+	} else {
+		return audio_put_block_real(a, block)
+	}
+}
+
 func audio_flush_fake(a int) int {
 	return 0
 }
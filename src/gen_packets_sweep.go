@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+//nolint:gochecknoglobals
+package direwolf
+
+/*------------------------------------------------------------------
+ *
+ * Name:	gen_packets_sweep
+ *
+ * Purpose:	Generate a noise-swept corpus of .WAV files in parallel.
+ *
+ * Description:	Qualifying a demodulator means decoding the same test
+ *		signal at many signal to noise ratios.  Synthesizing the
+ *		signal over and over for each noise level is the slow
+ *		part, so the clean signal is rendered exactly once and
+ *		each variant is then a pure function of that buffer:
+ *		add noise at one constant level and write it out.
+ *
+ *		That makes the variants independent, so a pool of
+ *		workers streams them to disk concurrently, in bounded
+ *		chunks, each with its own deterministic random number
+ *		generator.  Different modem profiles still require
+ *		separate invocations because the modem configuration
+ *		is process-wide state.
+ *
+ *----------------------------------------------------------------*/
+
+import (
+	"encoding/binary"
+	"fmt"
+	"os"
+	"path/filepath"
+	"runtime"
+	"strings"
+	"sync"
+	"sync/atomic"
+)
+
+/* Samples are processed and written this many bytes at a time so a */
+/* multi-gigabyte corpus needs only one clean copy in memory. */
+
+const SWEEP_CHUNK_SIZE = 65536
+
+/*------------------------------------------------------------------
+ *
+ * Name:        sweep_variant_name
+ *
+ * Purpose:     File name for one noise level, derived from the -o
+ *		name used as a template.  e.g. z.wav becomes z-001.wav.
+ *
+ *----------------------------------------------------------------*/
+
+func sweep_variant_name(template string, i int) string {
+	var ext = filepath.Ext(template)
+	var base = strings.TrimSuffix(template, ext)
+
+	if ext == "" {
+		ext = ".wav"
+	}
+
+	return fmt.Sprintf("%s-%03d%s", base, i, ext)
+} /* end sweep_variant_name */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        sweep_wav_header
+ *
+ * Purpose:     Build a .WAV header for a known data size.
+ *
+ * Description:	Unlike audio_file_open, the size is known up front
+ *		(it is the clean signal size) so there is no need to
+ *		seek back and patch the header afterwards.  That lets
+ *		the workers write strictly sequentially.
+ *
+ *----------------------------------------------------------------*/
+
+func sweep_wav_header(pa *audio_s, datasize int) wav_header {
+	var h wav_header
+
+	h.riff = [4]byte{'R', 'I', 'F', 'F'}
+	h.filesize = int32(datasize + binary.Size(new(wav_header)) - 8)
+	h.wave = [4]byte{'W', 'A', 'V', 'E'}
+	h.fmt = [4]byte{'f', 'm', 't', ' '}
+	h.fmtsize = 16   // Always 16.
+	h.wformattag = 1 // 1 for PCM.
+
+	h.nchannels = int16(pa.adev[0].num_channels)
+	h.nsamplespersec = int32(pa.adev[0].samples_per_sec)
+	h.wbitspersample = int16(pa.adev[0].bits_per_sample)
+
+	h.nblockalign = h.wbitspersample / 8 * h.nchannels
+	h.navgbytespersec = int32(h.nblockalign) * h.nsamplespersec
+	h.data = [4]byte{'d', 'a', 't', 'a'}
+	h.datasize = int32(datasize)
+
+	return h
+} /* end sweep_wav_header */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        sweep_write_variant
+ *
+ * Purpose:     Write one .WAV file: the clean signal plus noise at
+ *		one constant level.
+ *
+ * Inputs:	fname		- Output file name.
+ *
+ *		clean		- Rendered clean signal, 16 bit
+ *				  little endian samples.  Shared,
+ *				  read only.
+ *
+ *		pa		- Audio format for the header.
+ *
+ *		noise_level	- Constant level for the whole file.
+ *
+ *		seed		- Random number generator seed, so
+ *				  each variant is reproducible.
+ *
+ * Description:	Same noise formula as audio_put_fake but applied a
+ *		bounded chunk at a time with a local generator so
+ *		multiple variants can be written concurrently.
+ *
+ *----------------------------------------------------------------*/
+
+func sweep_write_variant(fname string, clean []byte, pa *audio_s, noise_level float64, seed int32) error {
+	var f, createErr = os.Create(fname) //nolint:gosec // Writing files derived from a user-supplied name is the point.
+	if createErr != nil {
+		return createErr
+	}
+
+	var headerErr = binary.Write(f, binary.LittleEndian, sweep_wav_header(pa, len(clean)))
+	if headerErr != nil {
+		f.Close()
+
+		return headerErr
+	}
+
+	var state = seed
+	var chunk = make([]byte, 0, SWEEP_CHUNK_SIZE)
+
+	for off := 0; off < len(clean); off += SWEEP_CHUNK_SIZE {
+		var end = min(off+SWEEP_CHUNK_SIZE, len(clean))
+
+		chunk = chunk[:0]
+
+		for k := off; k+1 < end; k += 2 {
+			var s = int32(int16(uint16(clean[k]) | uint16(clean[k+1])<<8))
+
+			/* Add random noise to the signal. */
+			/* r should be in range of -1 .. +1. */
+
+			state = int32((uint32(state)*1103515245 + 12345) & MY_RAND_MAX)
+			var r = (float64(state) - float64(MY_RAND_MAX)/2.0) / (float64(MY_RAND_MAX) / 2.0)
+
+			s += int32(5 * r * noise_level * 32767)
+
+			if s > 32767 {
+				s = 32767
+			}
+
+			if s < -32767 {
+				s = -32767
+			}
+
+			chunk = append(chunk, byte(s&0xff), byte(s>>8)&0xff)
+		}
+
+		var _, writeErr = f.Write(chunk)
+		if writeErr != nil {
+			f.Close()
+
+			return writeErr
+		}
+	}
+
+	return f.Close()
+} /* end sweep_write_variant */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        gen_packets_sweep
+ *
+ * Purpose:     Write the whole corpus: one file per noise level, on
+ *		parallel workers.
+ *
+ * Inputs:	clean		- Rendered clean signal.
+ *
+ *		template	- Output name from -o, used to derive
+ *				  the per-variant file names.
+ *
+ *		count		- Number of noise levels / files.
+ *
+ *		nworkers	- Worker pool size.  0 means one per CPU.
+ *
+ *		amplitude	- Signal amplitude, percent, for the
+ *				  noise level formula.
+ *
+ *		pa		- Audio configuration.
+ *
+ * Returns:	Process exit code, 0 for success.
+ *
+ *----------------------------------------------------------------*/
+
+func gen_packets_sweep(clean []byte, template string, count int, nworkers int, amplitude int, pa *audio_s) int {
+	if nworkers <= 0 {
+		nworkers = runtime.NumCPU()
+	}
+
+	if nworkers > count {
+		nworkers = count
+	}
+
+	text_color_set(DW_COLOR_INFO)
+	fmt.Printf("Noise sweep: %d files from one %d byte clean signal, %d workers.\n", count, len(clean), nworkers)
+
+	var jobs = make(chan int, count)
+
+	for i := 1; i <= count; i++ {
+		jobs <- i
+	}
+
+	close(jobs)
+
+	var failed atomic.Bool
+
+	var wg sync.WaitGroup
+	for range nworkers {
+		wg.Add(1)
+
+		go func() {
+			defer wg.Done()
+
+			for i := range jobs {
+				var noise_level = gen_packets_noise_level(pa.achan[0].baud, amplitude, float64(i)/float64(count))
+				var fname = sweep_variant_name(template, i)
+
+				var writeErr = sweep_write_variant(fname, clean, pa, noise_level, int32(i))
+				if writeErr != nil {
+					text_color_set(DW_COLOR_ERROR)
+					fmt.Printf("Couldn't write %s: %s\n", fname, writeErr)
+					failed.Store(true)
+
+					continue
+				}
+
+				fmt.Printf("Wrote %s, noise level %.4f\n", fname, noise_level)
+			}
+		}()
+	}
+
+	wg.Wait()
+
+	if failed.Load() {
+		return 1
+	}
+
+	return 0
+} /* end gen_packets_sweep */
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"encoding/binary"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+func TestSweepVariantName(t *testing.T) {
+	t.Parallel()
+
+	assert.Equal(t, "z-001.wav", sweep_variant_name("z.wav", 1))
+	assert.Equal(t, "corpus/z-042.wav", sweep_variant_name("corpus/z.wav", 42))
+	assert.Equal(t, "z-100.wav", sweep_variant_name("z", 100))
+}
+
+// A zero noise variant must be the clean signal with a valid header.
+func TestSweepWriteVariantZeroNoise(t *testing.T) {
+	t.Parallel()
+
+	var pa = new(audio_s)
+	pa.adev[0].num_channels = 1
+	pa.adev[0].samples_per_sec = 44100
+	pa.adev[0].bits_per_sample = 16
+
+	// A bit more than one chunk so the chunk boundary is exercised.
+	var clean = make([]byte, SWEEP_CHUNK_SIZE+1024)
+	for i := range clean {
+		clean[i] = byte(i * 7)
+	}
+
+	var fname = filepath.Join(t.TempDir(), "sweep.wav")
+
+	require.NoError(t, sweep_write_variant(fname, clean, pa, 0, 1))
+
+	var written, readErr = os.ReadFile(fname) //nolint:gosec
+	require.NoError(t, readErr)
+
+	var headerSize = binary.Size(new(wav_header))
+	require.Len(t, written, headerSize+len(clean))
+
+	assert.Equal(t, []byte("RIFF"), written[0:4])
+	assert.Equal(t, []byte("WAVE"), written[8:12])
+	assert.Equal(t, clean, written[headerSize:])
+}
+
+// Same seed must give the same file; different seeds must not.
+func TestSweepWriteVariantDeterministic(t *testing.T) {
+	t.Parallel()
+
+	var pa = new(audio_s)
+	pa.adev[0].num_channels = 1
+	pa.adev[0].samples_per_sec = 44100
+	pa.adev[0].bits_per_sample = 16
+
+	var clean = make([]byte, 4096)
+
+	var dir = t.TempDir()
+	var names = []string{"a.wav", "b.wav", "c.wav"}
+	var contents [][]byte
+
+	for i, name := range names {
+		var fname = filepath.Join(dir, name)
+		var seed = int32(1)
+		if i == 2 {
+			seed = 2
+		}
+
+		require.NoError(t, sweep_write_variant(fname, clean, pa, 0.01, seed))
+
+		var written, readErr = os.ReadFile(fname) //nolint:gosec
+		require.NoError(t, readErr)
+		contents = append(contents, written)
+	}
+
+	assert.Equal(t, contents[0], contents[1], "same seed should reproduce the same file")
+	assert.NotEqual(t, contents[0], contents[2], "different seeds should give different noise")
+}
@@ -417,138 +417,195 @@ func tone_gen_put_bit_real(channel int, dat int) {
 			int blend = 1;
 		#endif
 	*/
-	for { /* until enough audio samples for this symbol. */
-		var sam int
 
-		switch save_audio_config_p.achan[channel].modem_type {
-		case MODEM_AFSK:
-			/* TODO KG
-			#if DEBUG2
-				      text_color_set(DW_COLOR_DEBUG);
-				      dw_printf ("tone_gen_put_bit %d AFSK\n", __LINE__);
-			#endif
-			*/
-
-			// v1.7 reversed.
-			// Previously a data '1' selected the second (usually higher) tone.
-			// It never really mattered before because we were using NRZI.
-			// With the addition of IL2P, we need to be more careful.
-			// A data '1' should be the mark tone.
-			var change = f2_change_per_sample[channel]
-			if dat > 0 {
-				change = f1_change_per_sample[channel]
-			}
+	/*
+	 * Render the whole symbol as one block of samples.
+	 *
+	 * The phase increment per sample for each tone was precomputed in
+	 * gen_tone_init, so each sample is just an addition and a table
+	 * lookup.  Building the block in a reusable buffer and handing it
+	 * to the audio layer in one call is much cheaper than a function
+	 * call for every byte of every sample, which adds up quickly for
+	 * long FX.25 protected frames at low baud rates.
+	 */
 
-			tone_phase[channel] += change
-			sam = int(sine_table[(tone_phase[channel]>>24)&0xff])
-			gen_tone_put_sample(channel, a, sam)
+	/* How many samples until enough for the bit (symbol) time? */
 
-		case MODEM_EAS:
-			var change = f2_change_per_sample[channel]
-			if dat > 0 {
-				change = f1_change_per_sample[channel]
-			}
+	var nsamples = (ticks_per_bit[channel] - bit_len_acc[channel] + ticks_per_sample[channel] - 1) / ticks_per_sample[channel]
+	if nsamples < 1 {
+		nsamples = 1
+	}
 
-			tone_phase[channel] += change
-			sam = int(sine_table[(tone_phase[channel]>>24)&0xff])
-			gen_tone_put_sample(channel, a, sam)
+	bit_len_acc[channel] += nsamples*ticks_per_sample[channel] - ticks_per_bit[channel]
 
-		case MODEM_BPSK:
-			tone_phase[channel] += f1_change_per_sample[channel]
-			sam = int(sine_table[(tone_phase[channel]>>24)&0xff])
-			gen_tone_put_sample(channel, a, sam)
+	var change uint
 
-		case MODEM_QPSK:
-			/* TODO KG
-			#if DEBUG2
-				      text_color_set(DW_COLOR_DEBUG);
-				      dw_printf ("tone_gen_put_bit %d PSK\n", __LINE__);
-			#endif
-			*/
-			tone_phase[channel] += f1_change_per_sample[channel]
-			/*
-				#if PSKIQ
-				#if 1  // blend JWL
-					      // remove loop invariant
-					      float old_i = ci[xmit_prev_octant[channel]];
-					      float old_q = sq[xmit_prev_octant[channel]];
-
-					      float new_i = ci[xmit_octant[channel]];
-					      float new_q = sq[xmit_octant[channel]];
-
-					      float b = blend / samples_per_symbol[channel];	// roughly 0 to 1
-					      blend++;
-					     // b = (b - 0.5) * 20 + 0.5;
-					     // if (b < 0) b = 0;
-					     // if (b > 1) b = 1;
-						// b = b > 0.5;
-						//b = 1;		// 78 decoded with this.
-									// only 39 without.
-
-
-					      //float blended_i = new_i * b + old_i * (1.0f - b);
-					      //float blended_q = new_q * b + old_q * (1.0f - b);
-
-					      float blended_i = interpol8 (old_i, new_i, b);
-					      float blended_q = interpol8 (old_q, new_q, b);
-
-					      sam = blended_i * sine_table[((tone_phase[channel] - PHASE_SHIFT_90) >> 24) & 0xff] +
-					            blended_q * sine_table[(tone_phase[channel] >> 24) & 0xff];
-				#else  // jump
-					      sam = ci[xmit_octant[channel]] * sine_table[((tone_phase[channel] - PHASE_SHIFT_90) >> 24) & 0xff] +
-					            sq[xmit_octant[channel]] * sine_table[(tone_phase[channel] >> 24) & 0xff];
-				#endif
-				#else
-			*/
-			sam = int(sine_table[(tone_phase[channel]>>24)&0xff])
-			gen_tone_put_sample(channel, a, sam)
+	switch save_audio_config_p.achan[channel].modem_type {
+	case MODEM_AFSK, MODEM_EAS:
+		// v1.7 reversed.
+		// Previously a data '1' selected the second (usually higher) tone.
+		// It never really mattered before because we were using NRZI.
+		// With the addition of IL2P, we need to be more careful.
+		// A data '1' should be the mark tone.
+		change = f2_change_per_sample[channel]
+		if dat > 0 {
+			change = f1_change_per_sample[channel]
+		}
 
-		case MODEM_8PSK:
-			/* TODO KG
-			#if DEBUG2
-				      text_color_set(DW_COLOR_DEBUG);
-				      dw_printf ("tone_gen_put_bit %d PSK\n", __LINE__);
-			#endif
-			*/
-			tone_phase[channel] += f1_change_per_sample[channel]
-			sam = int(sine_table[(tone_phase[channel]>>24)&0xff])
-			gen_tone_put_sample(channel, a, sam)
+	case MODEM_BPSK, MODEM_QPSK, MODEM_8PSK:
+		// Any phase shift for the symbol was applied above.
+		change = f1_change_per_sample[channel]
 
-		case MODEM_BASEBAND, MODEM_SCRAMBLE, MODEM_AIS:
-			if dat != prev_dat[channel] {
-				tone_phase[channel] += f1_change_per_sample[channel]
+	case MODEM_BASEBAND, MODEM_SCRAMBLE, MODEM_AIS:
+		if dat != prev_dat[channel] {
+			change = f1_change_per_sample[channel]
+		} else {
+			// Steady tone for a repeated bit.  Snap the phase once;
+			// it stays put for the rest of the symbol.
+			if tone_phase[channel]&0x80000000 > 0 {
+				tone_phase[channel] = 0xc0000000 // 270 degrees.
 			} else {
-				if tone_phase[channel]&0x80000000 > 0 {
-					tone_phase[channel] = 0xc0000000 // 270 degrees.
-				} else {
-					tone_phase[channel] = 0x40000000 // 90 degrees.
-				}
+				tone_phase[channel] = 0x40000000 // 90 degrees.
 			}
 
-			sam = int(sine_table[(tone_phase[channel]>>24)&0xff])
-			gen_tone_put_sample(channel, a, sam)
-
-		default:
-			text_color_set(DW_COLOR_ERROR)
-			dw_printf("INTERNAL ERROR: achan[%d].modem_type = %d\n",
-				channel, save_audio_config_p.achan[channel].modem_type)
-			os.Exit(1)
+			change = 0
 		}
 
-		/* Enough for the bit time? */
+	default:
+		text_color_set(DW_COLOR_ERROR)
+		dw_printf("INTERNAL ERROR: achan[%d].modem_type = %d\n",
+			channel, save_audio_config_p.achan[channel].modem_type)
+		os.Exit(1)
+	}
 
-		bit_len_acc[channel] += ticks_per_sample[channel]
+	var block = gen_tone_block[channel][:0]
+	var phase = tone_phase[channel]
 
-		if bit_len_acc[channel] >= ticks_per_bit[channel] {
-			break
-		}
+	for range nsamples {
+		phase += change
+
+		// Samples come straight from the sine table so they cannot clip.
+		block = gen_tone_append_sample(block, channel, a, int(sine_table[(phase>>24)&0xff]))
 	}
 
-	bit_len_acc[channel] -= ticks_per_bit[channel]
+	tone_phase[channel] = phase
+	gen_tone_block[channel] = block
+
+	gen_tone_emit_block(channel, a, block)
 
 	prev_dat[channel] = dat // Only needed for G3RUH baseband/scrambled.
 } /* end tone_gen_put_bit */
 
+/*
+ * PSKIQ note: the old sample-at-a-time loop had the disabled I/Q
+ * blending experiment inline.  If that is ever resurrected it will need
+ * its own per-sample rendering here because the blend factor changes
+ * within the symbol.
+ */
+
+// Reusable per-channel buffer so block synthesis does not allocate for
+// every bit.  It grows to one symbol time (or one quiet gap) and stays.
+var gen_tone_block [MAX_RADIO_CHANS][]byte
+
+// When set, rendered sample blocks for the channel are collected here
+// instead of going to the audio device.  The transmit thread uses this
+// to render the next frame of a transmission while the previous one is
+// still being played out.  Only the thread that owns the channel's
+// transmit state may set it, so no locking is needed.
+var gen_tone_capture [MAX_RADIO_CHANS]*[]byte
+
+/*------------------------------------------------------------------
+ *
+ * Name:        gen_tone_emit_block
+ *
+ * Purpose:     Hand a block of rendered samples to the audio device,
+ *		or collect it when capture is active.
+ *
+ * Inputs:	channel	- Radio channel.
+ *
+ *		a	- Audio device for the channel.
+ *
+ *		block	- Samples in the device's byte layout.
+ *
+ *----------------------------------------------------------------*/
+
+func gen_tone_emit_block(channel int, a int, block []byte) {
+	if gen_tone_capture[channel] != nil {
+		*gen_tone_capture[channel] = append(*gen_tone_capture[channel], block...)
+		return
+	}
+
+	audio_put_block(a, block)
+} /* end gen_tone_emit_block */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        gen_tone_capture_begin / gen_tone_capture_end
+ *
+ * Purpose:     Start / stop collecting rendered samples for a channel
+ *		into the caller's buffer instead of the audio device.
+ *
+ * Inputs:	channel	- Radio channel.
+ *
+ *		buf	- Destination for the rendered samples.
+ *			  Appended to, so it can be reused across frames.
+ *
+ *----------------------------------------------------------------*/
+
+func gen_tone_capture_begin(channel int, buf *[]byte) {
+	gen_tone_capture[channel] = buf
+} /* end gen_tone_capture_begin */
+
+func gen_tone_capture_end(channel int) {
+	gen_tone_capture[channel] = nil
+} /* end gen_tone_capture_end */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        gen_tone_append_sample
+ *
+ * Purpose:     Pack one audio sample onto the end of a byte buffer.
+ *
+ * Inputs:	block	- Destination buffer.
+ *
+ *		channel	- Radio channel, for left/right placement.
+ *
+ *		a	- Audio device for the channel.
+ *
+ *		sam	- Sample value, -32768 .. +32767.
+ *
+ * Returns:     The buffer with the sample appended, in the same
+ *		mono/stereo and 8/16 bit layout that audio_put expects.
+ *
+ *----------------------------------------------------------------*/
+
+func gen_tone_append_sample(block []byte, channel int, a int, sam int) []byte {
+	if save_audio_config_p.adev[a].num_channels == 1 {
+		/* Mono */
+		if save_audio_config_p.adev[a].bits_per_sample == 8 {
+			return append(block, uint8(((sam+32768)>>8)&0xff))
+		}
+
+		return append(block, uint8(sam&0xff), uint8((sam>>8)&0xff))
+	}
+
+	if channel == ADEVFIRSTCHAN(a) {
+		/* Stereo, left channel. */
+		if save_audio_config_p.adev[a].bits_per_sample == 8 {
+			return append(block, uint8(((sam+32768)>>8)&0xff), 0)
+		}
+
+		return append(block, uint8(sam&0xff), uint8((sam>>8)&0xff), 0, 0)
+	}
+
+	/* Stereo, right channel. */
+	if save_audio_config_p.adev[a].bits_per_sample == 8 {
+		return append(block, 0, uint8(((sam+32768)>>8)&0xff))
+	}
+
+	return append(block, 0, 0, uint8(sam&0xff), uint8((sam>>8)&0xff))
+} /* end gen_tone_append_sample */
+
 func gen_tone_put_sample(channel int, a int, sam int) {
 	/* Ship out an audio sample. */
 	/* 16 bit is signed, little endian, range -32768 .. +32767 */
@@ -574,53 +631,27 @@ func gen_tone_put_sample(channel int, a int, sam int) {
 		sam = 32767
 	}
 
-	if save_audio_config_p.adev[a].num_channels == 1 {
-		/* Mono */
-		if save_audio_config_p.adev[a].bits_per_sample == 8 {
-			audio_put(a, uint8(((sam+32768)>>8)&0xff))
-		} else {
-			audio_put(a, uint8(sam&0xff))
-			audio_put(a, uint8((sam>>8)&0xff))
-		}
-	} else {
-		if channel == ADEVFIRSTCHAN(a) {
-			/* Stereo, left channel. */
-			if save_audio_config_p.adev[a].bits_per_sample == 8 {
-				audio_put(a, uint8(((sam+32768)>>8)&0xff))
-				audio_put(a, 0)
-			} else {
-				audio_put(a, uint8(sam&0xff))
-				audio_put(a, uint8((sam>>8)&0xff))
-
-				audio_put(a, 0)
-				audio_put(a, 0)
-			}
-		} else {
-			/* Stereo, right channel. */
-			if save_audio_config_p.adev[a].bits_per_sample == 8 {
-				audio_put(a, 0)
-				audio_put(a, uint8(((sam+32768)>>8)&0xff))
-			} else {
-				audio_put(a, 0)
-				audio_put(a, 0)
-
-				audio_put(a, uint8(sam&0xff))
-				audio_put(a, uint8((sam>>8)&0xff))
-			}
-		}
+	var scratch [4]byte
+	for _, c := range gen_tone_append_sample(scratch[:0], channel, a, sam) {
+		audio_put(a, c)
 	}
 }
 
 func gen_tone_put_quiet_ms(channel int, time_ms int) {
 	var a = ACHAN2ADEV(channel) /* device for channel. */
-	var sam = 0
 
 	var nsamples = int((float64(time_ms) * float64(save_audio_config_p.adev[a].samples_per_sec) / 1000.) + 0.5)
 
+	var block = gen_tone_block[channel][:0]
+
 	for range nsamples {
-		gen_tone_put_sample(channel, a, sam)
+		block = gen_tone_append_sample(block, channel, a, 0)
 	}
 
+	gen_tone_block[channel] = block
+
+	gen_tone_emit_block(channel, a, block)
+
 	// Avoid abrupt change when it starts up again.
 	tone_phase[channel] = 0
 }
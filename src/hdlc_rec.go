@@ -9,6 +9,7 @@ package direwolf
 
 import (
 	"slices"
+	"sync"
 )
 
 /* Undo data scrambling for 9600 baud. */
@@ -78,6 +79,12 @@ var num_subchannel [MAX_RADIO_CHANS]int //TODO1.2 use ptr rather than copy.
 
 var composite_dcd [MAX_RADIO_CHANS][MAX_SUBCHANS + 1][MAX_SLICERS]bool
 
+// The per-subchannel demodulator workers can report DCD changes for the
+// same radio channel concurrently.  The look-at-everything, update-my-cell,
+// look-again sequence in dcd_change_real, including the resulting ptt_set,
+// must be atomic per channel or edges can be missed or duplicated.
+var dcd_mutex [MAX_RADIO_CHANS]sync.Mutex
+
 /***********************************************************************************
  *
  * Name:	hdlc_rec_init
@@ -697,6 +704,9 @@ func dcd_change_real(channel int, subchannel int, slice int, state int) {
 		#endif
 	*/
 
+	dcd_mutex[channel].Lock()
+	defer dcd_mutex[channel].Unlock()
+
 	var old = hdlc_rec_data_detect_any(channel)
 
 	if state != 0 {
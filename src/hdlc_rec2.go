@@ -124,13 +124,6 @@ type retry_conf_t struct {
 // "2" was added to reduce confusion.  Can be trimmed down.
 
 type hdlc_state2_s struct {
-	prev_raw bool /* Keep track of previous bit so */
-	/* we can look for transitions. */
-
-	is_scrambled bool /* Set for 9600 baud. */
-	lfsr         int  /* Descrambler shift register for 9600 baud. */
-	prev_descram int  /* Previous unscrambled for 9600 baud. */
-
 	pat_det byte /* 8 bit pattern detector shift register. */
 	/* See below for more details. */
 
@@ -306,6 +299,17 @@ func try_to_fix_quick_now(block *rrbb_t, channel int, subchan int, slice int, al
 	//int passall = save_audio_config_p.achan[channel].passall;
 
 	var length = rrbb_get_len(block)
+
+	/* A cached decode of the unmodified block lets us predict the CRC */
+	/* of most trial inversions with a couple of table lookups and skip */
+	/* the full decode pass for the ones that provably can't match. */
+	/* nil (scrambled data, or no clean bit structure) means every */
+	/* attempt takes the full path, exactly as before. */
+
+	var fast = build_retry_fast_cache(block)
+
+	var sites [4]int
+
 	/* Prepare the retry configuration */
 
 	var retry_cfg = new(retry_conf_t)
@@ -328,6 +332,10 @@ func try_to_fix_quick_now(block *rrbb_t, channel int, subchan int, slice int, al
 		/* Set the index of the bit to swap */
 		retry_cfg.contig.bit_idx = i
 
+		if !retry_fast_might_succeed(fast, contig_flip_sites(sites[:0], i, 1, length), length) {
+			continue
+		}
+
 		var ok = try_decode(block, channel, subchan, slice, alevel, retry_cfg, false)
 		if ok {
 			/* TODO KG
@@ -353,6 +361,10 @@ func try_to_fix_quick_now(block *rrbb_t, channel int, subchan int, slice int, al
 	for i := 0; i < length-1; i++ {
 		retry_cfg.contig.bit_idx = i
 
+		if !retry_fast_might_succeed(fast, contig_flip_sites(sites[:0], i, 2, length), length) {
+			continue
+		}
+
 		var ok = try_decode(block, channel, subchan, slice, alevel, retry_cfg, false)
 		if ok {
 			/* TODO KG
@@ -378,6 +390,10 @@ func try_to_fix_quick_now(block *rrbb_t, channel int, subchan int, slice int, al
 	for i := 0; i < length-2; i++ {
 		retry_cfg.contig.bit_idx = i
 
+		if !retry_fast_might_succeed(fast, contig_flip_sites(sites[:0], i, 3, length), length) {
+			continue
+		}
+
 		var ok = try_decode(block, channel, subchan, slice, alevel, retry_cfg, false)
 		if ok {
 			/* TODO KG
@@ -395,6 +411,9 @@ func try_to_fix_quick_now(block *rrbb_t, channel int, subchan int, slice int, al
 	 * It chews up a lot of CPU time.  Usual test takes 4 times longer to run.
 	 *
 	 * Processing time is order N squared so time goes up rapidly with larger frames.
+	 * The FCS prediction above now rejects nearly all of the N squared pairs with
+	 * a few table lookups each, so only candidates that could actually produce a
+	 * matching FCS pay for a full decode pass.
 	 */
 	if fix_bits < RETRY_INVERT_TWO_SEP {
 		return false
@@ -420,6 +439,10 @@ func try_to_fix_quick_now(block *rrbb_t, channel int, subchan int, slice int, al
 		for j := i + 2; j < length; j++ {
 			retry_cfg.sep.bit_idx_b = j
 
+			if !retry_fast_might_succeed(fast, sep_flip_sites(sites[:0], i, j, length), length) {
+				continue
+			}
+
 			ok = try_decode(block, channel, subchan, slice, alevel, retry_cfg, false)
 			if ok {
 				break
@@ -475,34 +498,302 @@ func hdlc_rec2_try_to_fix_later(block *rrbb_t, channel int, subchan int, slice i
 } /* end hdlc_rec2_try_to_fix_later */
 
 /*
- * Check if the specified index of bit has been modified with the current type of configuration
- * Provide a specific implementation for contiguous mode to optimize number of tests done in the loop
+ * Apply the trial bit inversions described by the retry configuration.
+ *
+ * The bit buffer is packed so each inversion is a single XOR, and XOR
+ * is its own inverse: calling this a second time with the same
+ * configuration restores the original data.  That lets try_decode
+ * modify the buffer in place for each attempt instead of testing every
+ * bit position against the configuration while walking the buffer.
  */
 
-func is_contig_bit_modified(bit_idx int, retry_conf *retry_conf_t) bool {
-	var cont_bit_idx = retry_conf.contig.bit_idx
-	var cont_nr_bits = retry_conf.contig.nr_bits
+func apply_retry_flips(block *rrbb_t, retry_conf *retry_conf_t) {
+	if retry_conf._type != RETRY_TYPE_SWAP {
+		return
+	}
 
-	if bit_idx >= cont_bit_idx && (bit_idx < cont_bit_idx+cont_nr_bits) {
-		return true
+	if retry_conf.mode == RETRY_MODE_CONTIGUOUS {
+		for i := range retry_conf.contig.nr_bits {
+			rrbb_flip_bit(block, retry_conf.contig.bit_idx+i)
+		}
 	} else {
-		return false
+		if retry_conf.sep.bit_idx_a >= 0 {
+			rrbb_flip_bit(block, retry_conf.sep.bit_idx_a)
+		}
+
+		if retry_conf.sep.bit_idx_b >= 0 {
+			rrbb_flip_bit(block, retry_conf.sep.bit_idx_b)
+		}
+
+		if retry_conf.sep.bit_idx_c >= 0 {
+			rrbb_flip_bit(block, retry_conf.sep.bit_idx_c)
+		}
 	}
 }
 
+/***********************************************************************************
+ *
+ * Name:	build_retry_fast_cache
+ *
+ * Purpose:	Decode the unmodified block once and cache enough information
+ *		to predict, in constant time, what FCS a trial bit inversion
+ *		would produce.
+ *
+ * Inputs:	block	- Stream of bits that might be a frame.
+ *
+ * Returns:	Cache for use by retry_fast_might_succeed, or nil when the
+ *		fast path can't be used and every attempt must take the full
+ *		decode pass:
+ *
+ *		- Scrambled (9600 baud) data.  The G3RUH descrambler turns a
+ *		  single raw bit inversion into three decoded inversions and
+ *		  perturbs the descrambler state, so the simple site analysis
+ *		  below doesn't apply.
+ *
+ *		- The unmodified block doesn't decode to a whole number of
+ *		  octets of acceptable length.  (A trial inversion might still
+ *		  repair that by adding or removing a stuffed bit, which is
+ *		  exactly the structural change we can't predict cheaply.)
+ *
+ * Description:	The FCS is a linear function of the message bits: toggling
+ *		message bit p (LSB first, as transmitted) changes the CRC
+ *		register by a constant that depends only on how many bit-steps
+ *		remain after p.  We precompute those constants so the effect
+ *		of an inversion on the expected FCS is a single table lookup.
+ *
+ ***********************************************************************************/
+
+type retry_fast_cache_t struct {
+	dec []byte /* NRZI decoded value of each raw bit position. */
+	/* [0] is part of the opening flag; unused. */
+
+	kept []int32 /* Frame bit position for each raw bit position, */
+	/* or -1 where a stuffed bit was discarded. */
+
+	frame_len int /* Number of octets, including the FCS. */
+
+	expected uint16 /* FCS computed over the frame contents. */
+	actual   uint16 /* FCS field as received. */
+
+	contrib []uint16 /* contrib[r] is the change to the computed FCS */
+	/* from toggling the message bit that has r */
+	/* bit-steps remaining after it. */
+}
+
+func build_retry_fast_cache(block *rrbb_t) *retry_fast_cache_t {
+	if rrbb_get_is_scrambled(block) {
+		return nil
+	}
+
+	var blen = rrbb_get_len(block)
+	if blen < 2 {
+		return nil
+	}
+
+	var c = new(retry_fast_cache_t)
+	c.dec = make([]byte, blen)
+	c.kept = make([]int32, blen)
+
+	/* Same structural walk as try_decode, additionally recording the */
+	/* decoded bit values and which positions survive unstuffing. */
+
+	var frame_buf [MAX_FRAME_LEN]byte
+	var pat_det, oacc byte
+	var olen, frame_len, kept_count int
+	var prev_raw = rrbb_get_bit(block, 0) > 0
+
+	for i := 1; i < blen; i++ {
+		var raw = rrbb_get_bit(block, i) > 0
+		var dbit = raw == prev_raw
+		prev_raw = raw
+
+		if dbit {
+			c.dec[i] = 1
+		}
+		c.kept[i] = -1
+
+		pat_det >>= 1
+
+		if dbit {
+			pat_det |= 0x80
+			if pat_det == 0xfe {
+				return nil /* abort */
+			}
+			oacc >>= 1
+			oacc |= 0x80
+		} else {
+			if pat_det == 0x7e {
+				return nil /* flag */
+			} else if (pat_det >> 2) == 0x1f {
+				continue /* stuffed bit, discarded */
+			}
+			oacc >>= 1
+		}
+
+		c.kept[i] = int32(kept_count)
+		kept_count++
+
+		olen++
+		if (olen & 8) > 0 {
+			olen = 0
+			if frame_len >= MAX_FRAME_LEN {
+				return nil
+			}
+			frame_buf[frame_len] = oacc
+			frame_len++
+		}
+	}
+
+	if olen != 0 || frame_len < MIN_FRAME_LEN {
+		return nil
+	}
+
+	c.frame_len = frame_len
+	c.actual = uint16(frame_buf[frame_len-2]) | (uint16(frame_buf[frame_len-1]) << 8)
+	c.expected = fcs_calc(frame_buf[:frame_len-2])
+
+	/* The CRC register advance for one message bit of zero is */
+	/* delta' = (delta >> 1) ^ (delta & 1 ? 0x8408 : 0) and the */
+	/* immediate effect of a toggled bit is to XOR in 0x8408, so */
+	/* advancing 1 repeatedly enumerates all the contributions. */
+
+	var nbits = 8 * (frame_len - 2)
+
+	c.contrib = make([]uint16, nbits+1)
+
+	var delta = uint16(1)
+	for r := 1; r <= nbits; r++ {
+		if (delta & 1) > 0 {
+			delta = (delta >> 1) ^ 0x8408
+		} else {
+			delta >>= 1
+		}
+		c.contrib[r] = delta
+	}
+
+	return c
+} /* end build_retry_fast_cache */
+
+/***********************************************************************************
+ *
+ * Name:	retry_fast_might_succeed
+ *
+ * Purpose:	Decide whether a trial bit inversion could possibly produce a
+ *		frame with matching FCS.
+ *
+ * Inputs:	c	- Cache from build_retry_fast_cache, possibly nil.
+ *		sites	- Raw bit positions whose NRZI-decoded value the trial
+ *			  inversion toggles.  For a contiguous group of raw
+ *			  inversions only the two edges change; see
+ *			  contig_flip_sites / sep_flip_sites.
+ *		blen	- Number of bits in the block.
+ *
+ * Returns:	false only when the attempt provably can't yield a matching
+ *		FCS, so the caller can skip the full decode pass.  Any doubt -
+ *		no cache, or the inversion lands near enough to a run of ones
+ *		that the bit stuffing structure might change - returns true.
+ *
+ * Description:	If the stuffing decisions are unaffected, the trial frame
+ *		differs from the cached one only at the toggled positions, and
+ *		by linearity of the CRC the new expected FCS is the old one
+ *		XORed with a per-position constant.  Toggles landing in the
+ *		FCS field change the received FCS instead.
+ *
+ *		Stuffing decisions can only change where five ones appear or
+ *		disappear, which needs a run of at least four ones near a
+ *		toggled position in the original or modified data.  We check
+ *		for that conservatively and fall back to the full path.
+ *
+ ***********************************************************************************/
+
+func retry_fast_might_succeed(c *retry_fast_cache_t, sites []int, blen int) bool {
+	if c == nil {
+		return true
+	}
+
+	/* A stuffing decision at position k examines decoded bits k-5 .. k */
+	/* so only decisions within 5 positions of a toggle can differ. */
+	/* Scan a generous window around each toggle for long runs of ones */
+	/* in either the original or the modified data. */
+
+	for _, s := range sites {
+		var run_orig, run_mod = 0, 0
+
+		for j := max(1, s-10); j < min(blen, s+11); j++ {
+			var orig = c.dec[j]
+			var mod = orig
+			for _, t := range sites {
+				if j == t {
+					mod ^= 1
+				}
+			}
+
+			if orig > 0 {
+				run_orig++
+			} else {
+				run_orig = 0
+			}
+			if mod > 0 {
+				run_mod++
+			} else {
+				run_mod = 0
+			}
+
+			if run_orig >= 4 || run_mod >= 4 {
+				return true
+			}
+		}
+	}
+
+	/* Structure is provably unchanged.  Predict the FCS comparison. */
+
+	var expected = c.expected
+	var actual = c.actual
+	var nbits = 8 * (c.frame_len - 2)
+
+	for _, s := range sites {
+		var p = int(c.kept[s])
+		if p < 0 {
+			return true /* paranoia - the run check should prevent this */
+		}
+
+		if p < nbits {
+			expected ^= c.contrib[nbits-p]
+		} else {
+			actual ^= 1 << (p - nbits)
+		}
+	}
+
+	return expected == actual
+} /* end retry_fast_might_succeed */
+
 /*
- * Check  if the specified index of bit has been modified with the current type of configuration in separated bit index mode
- * Provide a specific implementation for separated mode to optimize number of tests done in the loop
+ * Raw bit positions where the NRZI-decoded data changes for each kind of
+ * trial inversion.  Inverting a contiguous group of raw bits toggles the
+ * decoded value only at the two edges of the group; two separated raw
+ * inversions toggle the decoded value at each position and its successor.
+ * (Position 0 is the tail of the opening flag and is never decoded.)
  */
 
-func is_sep_bit_modified(bit_idx int, retry_conf *retry_conf_t) bool {
-	if bit_idx == retry_conf.sep.bit_idx_a ||
-		bit_idx == retry_conf.sep.bit_idx_b ||
-		bit_idx == retry_conf.sep.bit_idx_c {
-		return true
-	} else {
-		return false
+func contig_flip_sites(sites []int, bit_idx int, nr_bits int, blen int) []int {
+	if bit_idx >= 1 {
+		sites = append(sites, bit_idx)
+	}
+	if bit_idx+nr_bits < blen {
+		sites = append(sites, bit_idx+nr_bits)
 	}
+	return sites
+}
+
+func sep_flip_sites(sites []int, bit_idx_a int, bit_idx_b int, blen int) []int {
+	if bit_idx_a >= 1 {
+		sites = append(sites, bit_idx_a)
+	}
+	sites = append(sites, bit_idx_a+1, bit_idx_b)
+	if bit_idx_b+1 < blen {
+		sites = append(sites, bit_idx_b+1)
+	}
+	return sites
 }
 
 /***********************************************************************************
@@ -548,29 +839,22 @@ func is_sep_bit_modified(bit_idx int, retry_conf *retry_conf_t) bool {
  *
  ***********************************************************************************/
 
+var hdlc_metrics_decode_attempts = metrics_counter("hdlc_decode_attempts_total") //nolint:gochecknoglobals
+var hdlc_metrics_retry_fixed = metrics_counter("hdlc_retry_fixed_total")         //nolint:gochecknoglobals
+
 func try_decode(block *rrbb_t, channel int, subchan int, slice int, alevel ALevel, retry_conf *retry_conf_t, passall bool) bool {
-	var retry_conf_mode = retry_conf.mode
 	var retry_conf_type = retry_conf._type
 	var retry_conf_retry = retry_conf.retry
 
-	var H2 hdlc_state2_s
+	hdlc_metrics_decode_attempts.incr()
 
-	H2.is_scrambled = rrbb_get_is_scrambled(block)
-	H2.prev_descram = rrbb_get_prev_descram(block)
-	H2.lfsr = rrbb_get_descram_state(block)
-	H2.prev_raw = rrbb_get_bit(block, 0) > 0 /* Actually last bit of the */
-	/* opening flag so we can derive the */
-	/* first data bit.  */
+	/* Apply the trial inversions in place - a couple of XORs - and */
+	/* restore the original data on the way out, whatever the outcome. */
 
-	/* Does this make sense? */
-	/* This is the last bit of the "flag" pattern. */
-	/* If it was corrupted we wouldn't have detected */
-	/* the start of frame. */
+	apply_retry_flips(block, retry_conf)
+	defer apply_retry_flips(block, retry_conf)
 
-	if (retry_conf.mode == RETRY_MODE_CONTIGUOUS && is_contig_bit_modified(0, retry_conf)) ||
-		(retry_conf.mode == RETRY_MODE_SEPARATED && is_sep_bit_modified(0, retry_conf)) {
-		H2.prev_raw = !H2.prev_raw
-	}
+	var H2 hdlc_state2_s
 
 	H2.pat_det = 0
 	H2.oacc = 0
@@ -579,6 +863,22 @@ func try_decode(block *rrbb_t, channel int, subchan int, slice int, alevel ALeve
 
 	var blen = rrbb_get_len(block)
 
+	/*
+	 * Undo the scrambling (if any) and NRZI encoding for the whole
+	 * buffer up front, 64 bits per step, rather than shifting the
+	 * descrambler along one bit at a time.  Any trial inversions were
+	 * already XORed into the packed buffer so this single pass sees
+	 * them with no per-bit position tests.
+	 *
+	 * Bit 0 is the last bit of the "flag" pattern; it is only used
+	 * to derive the first data bit.  If it was corrupted we wouldn't
+	 * have detected the start of frame.  A trial inversion of bit 0
+	 * was applied above like any other position.
+	 */
+
+	var dbits [RRBB_NUM_WORDS]uint64
+	rrbb_compute_dbits(block, dbits[:])
+
 	/* TODO KG
 	#if DEBUGx
 		text_color_set(DW_COLOR_DEBUG);
@@ -587,52 +887,13 @@ func try_decode(block *rrbb_t, channel int, subchan int, slice int, alevel ALeve
 	#endif
 	*/
 	for i := 1; i < blen; i++ {
-		/* Get the value for the current bit */
-		var raw = rrbb_get_bit(block, i) > 0
-		/* If swap two sep mode , swap the bit if needed */
-		if retry_conf_retry == RETRY_INVERT_TWO_SEP {
-			if is_sep_bit_modified(i, retry_conf) {
-				raw = !raw
-			}
-		} else if retry_conf_mode == RETRY_MODE_CONTIGUOUS {
-			/* Else handle all the others contiguous modes */
-			if retry_conf_type == RETRY_TYPE_SWAP {
-				/* If this is the bit to swap */
-				if is_contig_bit_modified(i, retry_conf) {
-					raw = !raw
-				}
-			}
-		}
+		var dbit = (dbits[i>>6]>>(uint(i)&63))&1 != 0
 		/*
 		 * Octets are sent LSB first.
 		 * Shift the most recent 8 bits thru the pattern detector.
 		 */
 		H2.pat_det >>= 1
 
-		/*
-		 * Using NRZI encoding,
-		 *   A '0' bit is represented by an inversion since previous bit.
-		 *   A '1' bit is represented by no change.
-		 *   Note: this code can be factorized with the raw != H2.prev_raw code at the cost of processing time
-		 */
-
-		var dbit bool
-
-		if H2.is_scrambled {
-			var _raw = 0
-			if raw {
-				_raw = 1
-			}
-			var descram = descramble(_raw, &(H2.lfsr))
-
-			dbit = (descram == H2.prev_descram)
-			H2.prev_descram = descram
-			H2.prev_raw = raw
-		} else {
-			dbit = (raw == H2.prev_raw)
-			H2.prev_raw = raw
-		}
-
 		if dbit {
 			H2.pat_det |= 0x80
 			/* Valid data will never have 7 one bits in a row: exit. */
@@ -740,6 +1001,10 @@ func try_decode(block *rrbb_t, channel int, subchan int, slice int, alevel ALeve
 					0,
 				) /* len-2 to remove FCS. */
 
+				if retry_conf_type != RETRY_TYPE_NONE {
+					hdlc_metrics_retry_fixed.incr()
+				}
+
 				return true
 			} else {
 				return false /* did not pass sanity check */
@@ -753,6 +1018,10 @@ func try_decode(block *rrbb_t, channel int, subchan int, slice int, alevel ALeve
 			Assert(rrbb_get_subchan(block) == subchan)
 			multi_modem_process_rec_frame(channel, subchan, slice, H2.frame_buf[:H2.frame_len-2], alevel, retry_conf.retry, 0) /* len-2 to remove FCS. */
 
+			if retry_conf_type != RETRY_TYPE_NONE {
+				hdlc_metrics_retry_fixed.incr()
+			}
+
 			return true /* success */
 		} else if passall {
 			if retry_conf_retry == RETRY_NONE && retry_conf_type == RETRY_TYPE_NONE {
@@ -117,6 +117,18 @@ var dp_queue_head *packet_t
 
 var igate_sock net.Conn
 
+/*
+ * Outbound messages are queued here and written to the socket by
+ * igate_writer_thread.  This way a slow or stalled connection to the
+ * server does not block the radio receive processing path.
+ */
+
+const IGATE_UPLINK_QUEUE_MAX = 100 /* Messages waiting for the writer before we start dropping. */
+
+const IGATE_UPLINK_COALESCE_MS = 5 /* Gather messages arriving close together into a single write. */
+
+var uplink_queue chan []byte
+
 /*
  * After connecting to server, we want to make sure
  * that the login sequence is sent first.
@@ -179,6 +191,11 @@ var stats_downlink_bytes int //nolint:unused
 /* Total number of bytes from IGate server including */
 /* packets, heartbeats, other messages. */
 
+var stats_uplink_drops int //nolint:unused
+/* Number of messages discarded because the uplink */
+/* queue was full.  Nonzero means the connection to */
+/* the server could not keep up with traffic. */
+
 var stats_downlink_packets int /* Number of packets from IGate server for possible transmission. */
 /* Fewer might be transmitted due to filtering or rate limiting. */
 
@@ -278,6 +295,9 @@ func igate_init(p_audio_config *audio_s, p_igate_config *igate_config_s, p_digi_
 	stats_downlink_packets = 0
 	stats_rf_xmit_packets = 0
 	stats_msg_cnt = 0
+	stats_uplink_drops = 0
+
+	uplink_queue = make(chan []byte, IGATE_UPLINK_QUEUE_MAX)
 
 	rx_to_ig_init()
 	ig_to_tx_init()
@@ -298,6 +318,12 @@ func igate_init(p_audio_config *audio_s, p_igate_config *igate_config_s, p_digi_
 
 	go connect_thread()
 
+	/*
+	 * This drains the outbound queue and writes to the socket.
+	 */
+
+	go igate_writer_thread()
+
 	/*
 	 * This reads messages from client when igate_sock is valid.
 	 */
@@ -421,7 +447,7 @@ func connect_thread() {
 		}
 
 		if igate_sock != nil {
-			/* This will close the socket if any error. */
+			/* The writer thread will close the socket if any error. */
 			send_msg_to_server("#")
 		}
 	}
@@ -795,8 +821,10 @@ func send_packet_to_server(pp *packet_t, channel int) {
  *			  It could contain nul characters so we can't
  *			  use the normal C string functions.
  *
- * Description:	Send message to IGate Server if connected.
- *		Disconnect from server, and notify user, if any error.
+ * Description:	Queue message for the IGate Server if connected.
+ *		The actual socket write happens in igate_writer_thread so
+ *		a slow connection can't stall the caller.  If the queue is
+ *		full, the oldest message is dropped to make room.
  *		Should use a word other than message because that has
  *		a specific meaning for APRS.
  *
@@ -827,15 +855,74 @@ func send_msg_to_server(imsg string) {
 
 	stats_uplink_bytes += len(imsg)
 
-	var _, err = igate_sock.Write([]byte(imsg)) // TODO KG Should imsg just be a []byte?
-	if err != nil {
-		text_color_set(DW_COLOR_ERROR)
-		dw_printf("\nError sending to IGate server.  Closing connection.\n\n")
-		igate_sock.Close()
-		igate_sock = nil
+	for {
+		select {
+		case uplink_queue <- []byte(imsg):
+			return
+		default:
+		}
+
+		/* Queue is full.  Drop the oldest message and try again. */
+
+		select {
+		case <-uplink_queue:
+			stats_uplink_drops++
+
+			if s_debug >= 1 {
+				text_color_set(DW_COLOR_ERROR)
+				dw_printf("Rx IGate: Uplink queue full.  Dropping oldest message.\n")
+			}
+		default:
+		}
 	}
 } /* end send_msg_to_server */
 
+/*-------------------------------------------------------------------
+ *
+ * Name:        igate_writer_thread
+ *
+ * Purpose:     Write queued messages to the IGate server.
+ *
+ * Description:	Take messages from the uplink queue and write them to
+ *		the socket.  Messages arriving close together - such as
+ *		a burst from digipeating - are gathered into a single
+ *		write rather than one system call per packet.
+ *		Disconnect from server, and notify user, if any error.
+ *
+ *--------------------------------------------------------------------*/
+
+func igate_writer_thread() {
+	for {
+		var outgoing = <-uplink_queue
+
+		/* Give any others arriving right behind it a chance to be combined. */
+
+		SLEEP_MS(IGATE_UPLINK_COALESCE_MS)
+
+		for more := true; more; {
+			select {
+			case imsg := <-uplink_queue:
+				outgoing = append(outgoing, imsg...)
+			default:
+				more = false
+			}
+		}
+
+		var conn = igate_sock
+		if conn == nil {
+			continue /* Connection was lost while queued.  Discard. */
+		}
+
+		var _, err = conn.Write(outgoing)
+		if err != nil {
+			text_color_set(DW_COLOR_ERROR)
+			dw_printf("\nError sending to IGate server.  Closing connection.\n\n")
+			conn.Close()
+			igate_sock = nil
+		}
+	}
+} /* end igate_writer_thread */
+
 /*-------------------------------------------------------------------
  *
  * Name:        get1ch
@@ -847,23 +934,37 @@ func send_msg_to_server(imsg string) {
  * Returns:	One byte from stream.
  *		Waits and tries again later if any error.
  *
+ * Description:	Reads from the socket in chunks, rather than one system
+ *		call per byte, and hands out the buffered bytes one at a
+ *		time.  No locking is needed because this is called only
+ *		from igate_recv_thread.
  *
  *--------------------------------------------------------------------*/
 
+var dnl_buf = make([]byte, 0, 4096) /* Bytes read from server, not yet consumed. */
+var dnl_buf_next int                /* Index of next byte to hand out. */
+
 func get1ch() byte {
 	for {
-		for igate_sock == nil {
+		if dnl_buf_next < len(dnl_buf) {
+			var ch = dnl_buf[dnl_buf_next]
+			dnl_buf_next++
+
+			return (ch)
+		}
+
+		var conn = igate_sock
+		for conn == nil {
 			SLEEP_SEC(5) /* Not connected.  Try again later. */
+			conn = igate_sock
 		}
 
-		/* Just get one byte at a time. */
-		// TODO: might read complete packets and unpack from own buffer
-		// rather than using a system call for each byte.
+		dnl_buf = dnl_buf[:cap(dnl_buf)]
+		dnl_buf_next = 0
 
-		var ch = make([]byte, 1)
-		var n, _ = igate_sock.Read(ch)
+		var n, _ = conn.Read(dnl_buf)
 
-		if n == 1 {
+		if n > 0 {
 			/* TODO KG
 			#if DEBUG9
 				    dw_printf (log_fp, "%02x %c %c", ch,
@@ -874,12 +975,16 @@ func get1ch() byte {
 				    fprintf (log_fp, "\n");
 			#endif
 			*/
-			return (ch[0])
+			dnl_buf = dnl_buf[:n]
+
+			continue
 		}
 
+		dnl_buf = dnl_buf[:0]
+
 		text_color_set(DW_COLOR_ERROR)
 		dw_printf("\nError reading from IGate server.  Closing connection.\n\n")
-		igate_sock.Close()
+		conn.Close()
 		igate_sock = nil
 	}
 } /* end get1ch */
@@ -1546,19 +1651,49 @@ func maybe_xmit_packet_from_igate(message []byte, to_chan int) {
  *
  *--------------------------------------------------------------------*/
 
-const RX2IG_HISTORY_MAX = 30 /* Remember the last 30 sent to IGate server. */
+/*
+ * Earlier versions kept a small fixed array of the last 30 checksums
+ * and scanned it linearly for every candidate packet.  During band
+ * openings the history overflowed (so duplicates slipped thru) and the
+ * scans ran on the same thread that talks to the APRS-IS socket.
+ *
+ * Now the cache is a hash map from checksum to the time it was last
+ * sent, so the check is a single lookup however busy the channel is.
+ * Entries older than the (configurable) dedupe time are swept out
+ * periodically, so memory usage follows the actual traffic within the
+ * dedupe window rather than a fixed history length.
+ *
+ * A map, unlike the old arrays, must not be accessed concurrently at
+ * all, so this now has the mutex the old code shrugged off.
+ */
 
-var rx2ig_insert_next int
-var rx2ig_time_stamp [RX2IG_HISTORY_MAX]time.Time
-var rx2ig_checksum [RX2IG_HISTORY_MAX]int
+var rx2ig_mutex sync.Mutex
+var rx2ig_seen map[int]time.Time /* Checksum -> when last sent to the server. */
+var rx2ig_last_sweep time.Time
 
 func rx_to_ig_init() {
-	for n := range RX2IG_HISTORY_MAX {
-		rx2ig_time_stamp[n] = time.Time{}
-		rx2ig_checksum[n] = 0
+	rx2ig_mutex.Lock()
+	rx2ig_seen = make(map[int]time.Time)
+	rx2ig_last_sweep = time.Now()
+	rx2ig_mutex.Unlock()
+}
+
+/* Discard expired entries.  At most one sweep per dedupe window.  Caller holds mutex. */
+
+func rx2ig_sweep(now time.Time) {
+	var window = time.Duration(save_igate_config_p.rx2ig_dedupe_time) * time.Second
+
+	if now.Sub(rx2ig_last_sweep) < window {
+		return
 	}
 
-	rx2ig_insert_next = 0
+	rx2ig_last_sweep = now
+
+	for crc, when := range rx2ig_seen {
+		if when.Before(now.Add(-window)) {
+			delete(rx2ig_seen, crc)
+		}
+	}
 }
 
 func rx_to_ig_remember(pp *packet_t) {
@@ -1567,8 +1702,13 @@ func rx_to_ig_remember(pp *packet_t) {
 		return
 	}
 
-	rx2ig_time_stamp[rx2ig_insert_next] = time.Now()
-	rx2ig_checksum[rx2ig_insert_next] = int(ax25_dedupe_crc(pp))
+	var now = time.Now()
+	var crc = int(ax25_dedupe_crc(pp))
+
+	rx2ig_mutex.Lock()
+	rx2ig_seen[crc] = now
+	rx2ig_sweep(now)
+	rx2ig_mutex.Unlock()
 
 	if s_debug >= 3 {
 		var src = ax25_get_addr_with_ssid(pp, AX25_SOURCE)
@@ -1576,17 +1716,10 @@ func rx_to_ig_remember(pp *packet_t) {
 		var pinfo = AX25GetInfo(pp)
 
 		text_color_set(DW_COLOR_DEBUG)
-		dw_printf("rx_to_ig_remember [%d] = %s %d \"%s>%s:%s\"\n",
-			rx2ig_insert_next,
-			rx2ig_time_stamp[rx2ig_insert_next].String(),
-			rx2ig_checksum[rx2ig_insert_next],
+		dw_printf("rx_to_ig_remember = %s %d \"%s>%s:%s\"\n",
+			now.String(), crc,
 			src, dest, string(pinfo))
 	}
-
-	rx2ig_insert_next++
-	if rx2ig_insert_next >= RX2IG_HISTORY_MAX {
-		rx2ig_insert_next = 0
-	}
 }
 
 func rx_to_ig_allow(pp *packet_t) bool {
@@ -1615,16 +1748,17 @@ func rx_to_ig_allow(pp *packet_t) bool {
 
 	// Yes, check for duplicates within certain time.
 
-	for j := range RX2IG_HISTORY_MAX {
-		if rx2ig_checksum[j] == int(crc) && !rx2ig_time_stamp[j].Before(now.Add(-time.Duration(save_igate_config_p.rx2ig_dedupe_time)*time.Second)) {
-			if s_debug >= 2 {
-				text_color_set(DW_COLOR_DEBUG)
-				// could be multiple entries and this might not be the most recent.
-				dw_printf("rx_to_ig_allow? NO. Seen %d seconds ago.\n", int(time.Since(rx2ig_time_stamp[j]).Seconds()))
-			}
+	rx2ig_mutex.Lock()
+	var seen, found = rx2ig_seen[int(crc)]
+	rx2ig_mutex.Unlock()
 
-			return false
+	if found && !seen.Before(now.Add(-time.Duration(save_igate_config_p.rx2ig_dedupe_time)*time.Second)) {
+		if s_debug >= 2 {
+			text_color_set(DW_COLOR_DEBUG)
+			dw_printf("rx_to_ig_allow? NO. Seen %d seconds ago.\n", int(time.Since(seen).Seconds()))
 		}
+
+		return false
 	}
 
 	if s_debug >= 2 {
@@ -1836,26 +1970,73 @@ No, we sent it recently by the digipeating function (note "bydigi=1").
 */
 
 const IG2TX_DEDUPE_TIME = 60 * time.Second /* Do not send duplicate within 60 seconds. */
-const IG2TX_HISTORY_MAX = 50               /* Remember the last 50 sent from server to radio. */
 
-/* Ideally this should be a critical region because */
-/* it is being written by two threads but I'm not that concerned. */
+/*
+ * Same hash-indexed arrangement as the RF>IS direction above, with two
+ * additions:  the key includes the radio channel, and we keep a
+ * chronological list of IGate (not digipeater) transmit times per
+ * channel for the 1 and 5 minute rate limits, trimmed as it is used so
+ * it never holds more than the last 5 minutes.
+ *
+ * The old fixed arrays were written by two threads with a comment
+ * saying a critical region would be ideal.  With maps that is no
+ * longer optional, hence the mutex.
+ */
+
+type ig2tx_key_t struct {
+	crc     int
+	channel int
+}
+
+type ig2tx_entry_t struct {
+	time_stamp time.Time
+	bydigi     int
+}
 
-var ig2tx_insert_next int
-var ig2tx_time_stamp [IG2TX_HISTORY_MAX]time.Time
-var ig2tx_checksum [IG2TX_HISTORY_MAX]int
-var ig2tx_chan [IG2TX_HISTORY_MAX]int
-var ig2tx_bydigi [IG2TX_HISTORY_MAX]int
+var ig2tx_mutex sync.Mutex
+var ig2tx_seen map[ig2tx_key_t]ig2tx_entry_t
+var ig2tx_sent map[int][]time.Time /* Channel -> IGate transmit times, oldest first. */
+var ig2tx_last_sweep time.Time
 
 func ig_to_tx_init() {
-	for n := range IG2TX_HISTORY_MAX {
-		ig2tx_time_stamp[n] = time.Time{}
-		ig2tx_checksum[n] = 0
-		ig2tx_chan[n] = 0xff
-		ig2tx_bydigi[n] = 0
+	ig2tx_mutex.Lock()
+	ig2tx_seen = make(map[ig2tx_key_t]ig2tx_entry_t)
+	ig2tx_sent = make(map[int][]time.Time)
+	ig2tx_last_sweep = time.Now()
+	ig2tx_mutex.Unlock()
+}
+
+/* Discard expired dedupe entries.  At most one sweep per dedupe window.  Caller holds mutex. */
+
+func ig2tx_sweep(now time.Time) {
+	if now.Sub(ig2tx_last_sweep) < IG2TX_DEDUPE_TIME {
+		return
 	}
 
-	ig2tx_insert_next = 0
+	ig2tx_last_sweep = now
+
+	for key, entry := range ig2tx_seen {
+		if entry.time_stamp.Before(now.Add(-IG2TX_DEDUPE_TIME)) {
+			delete(ig2tx_seen, key)
+		}
+	}
+}
+
+/* Drop transmit times older than the 5 minute rate limit window.  Caller holds mutex. */
+
+func ig2tx_trim_sent(times []time.Time, now time.Time) []time.Time {
+	var cutoff = now.Add(-300 * time.Second)
+
+	var keep = 0
+	for keep < len(times) && times[keep].Before(cutoff) {
+		keep++
+	}
+
+	if keep > 0 {
+		times = append(times[:0], times[keep:]...)
+	}
+
+	return times
 }
 
 func ig_to_tx_remember(pp *packet_t, channel int, bydigi int) {
@@ -1868,22 +2049,25 @@ func ig_to_tx_remember(pp *packet_t, channel int, bydigi int) {
 		var pinfo = AX25GetInfo(pp)
 
 		text_color_set(DW_COLOR_DEBUG)
-		dw_printf("ig_to_tx_remember [%d] = ch%d d%d %s %d \"%s>%s:%s\"\n",
-			ig2tx_insert_next,
+		dw_printf("ig_to_tx_remember = ch%d d%d %s %d \"%s>%s:%s\"\n",
 			channel, bydigi,
 			now.String(), crc,
 			src, dest, string(pinfo))
 	}
 
-	ig2tx_time_stamp[ig2tx_insert_next] = now
-	ig2tx_checksum[ig2tx_insert_next] = int(crc)
-	ig2tx_chan[ig2tx_insert_next] = channel
-	ig2tx_bydigi[ig2tx_insert_next] = bydigi
+	ig2tx_mutex.Lock()
+
+	ig2tx_seen[ig2tx_key_t{crc: int(crc), channel: channel}] = ig2tx_entry_t{time_stamp: now, bydigi: bydigi}
+
+	/* IGate transmit counts must not include digipeater transmissions. */
 
-	ig2tx_insert_next++
-	if ig2tx_insert_next >= IG2TX_HISTORY_MAX {
-		ig2tx_insert_next = 0
+	if bydigi == 0 {
+		ig2tx_sent[channel] = append(ig2tx_trim_sent(ig2tx_sent[channel], now), now)
 	}
+
+	ig2tx_sweep(now)
+
+	ig2tx_mutex.Unlock()
 }
 
 func ig_to_tx_allow(pp *packet_t, channel int) bool {
@@ -1902,48 +2086,44 @@ func ig_to_tx_allow(pp *packet_t, channel int) bool {
 
 	/* Consider transmissions on this channel only by either digi or IGate. */
 
-	for j := range IG2TX_HISTORY_MAX {
-		if ig2tx_checksum[j] == int(crc) && ig2tx_chan[j] == channel && !ig2tx_time_stamp[j].Before(now.Add(-IG2TX_DEDUPE_TIME)) {
-			/* We have a duplicate within some time period. */
-			if is_message_message(string(pinfo)) {
-				/* I think I want to avoid the duplicate suppression for "messages." */
-				/* Suppose we transmit a message from station X and it doesn't get an ack back. */
-				/* Station X then sends exactly the same thing 20 seconds later.  */
-				/* We don't want to suppress the retry. */
-				if s_debug >= 2 {
-					text_color_set(DW_COLOR_DEBUG)
-					dw_printf("ig_to_tx_allow? Yes for duplicate message sent %d seconds ago. bydigi=%d\n", int(time.Since(ig2tx_time_stamp[j]).Seconds()), ig2tx_bydigi[j])
-				}
-			} else {
-				/* Normal (non-message) case. */
-				if s_debug >= 2 {
-					text_color_set(DW_COLOR_DEBUG)
-					// could be multiple entries and this might not be the most recent.
-					dw_printf("ig_to_tx_allow? NO. Duplicate sent %d seconds ago. bydigi=%d\n", int(time.Since(ig2tx_time_stamp[j]).Seconds()), ig2tx_bydigi[j])
-				}
+	ig2tx_mutex.Lock()
 
-				text_color_set(DW_COLOR_INFO)
-				dw_printf("Tx IGate: Drop duplicate packet transmitted recently.\n")
+	var entry, found = ig2tx_seen[ig2tx_key_t{crc: int(crc), channel: channel}]
 
-				return false
-			}
-		}
-	}
-
-	/* IGate transmit counts must not include digipeater transmissions. */
+	var times = ig2tx_trim_sent(ig2tx_sent[channel], now)
+	ig2tx_sent[channel] = times
 
+	var count_5 = len(times)
 	var count_1 = 0
-	var count_5 = 0
 
-	for j := range IG2TX_HISTORY_MAX {
-		if ig2tx_chan[j] == channel && ig2tx_bydigi[j] == 0 {
-			if !ig2tx_time_stamp[j].Before(time.Now().Add(-60 * time.Second)) {
-				count_1++
-			}
+	for j := len(times) - 1; j >= 0 && !times[j].Before(now.Add(-60*time.Second)); j-- {
+		count_1++
+	}
+
+	ig2tx_mutex.Unlock()
 
-			if !ig2tx_time_stamp[j].Before(time.Now().Add(-300 * time.Second)) {
-				count_5++
+	if found && !entry.time_stamp.Before(now.Add(-IG2TX_DEDUPE_TIME)) {
+		/* We have a duplicate within some time period. */
+		if is_message_message(string(pinfo)) {
+			/* I think I want to avoid the duplicate suppression for "messages." */
+			/* Suppose we transmit a message from station X and it doesn't get an ack back. */
+			/* Station X then sends exactly the same thing 20 seconds later.  */
+			/* We don't want to suppress the retry. */
+			if s_debug >= 2 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("ig_to_tx_allow? Yes for duplicate message sent %d seconds ago. bydigi=%d\n", int(time.Since(entry.time_stamp).Seconds()), entry.bydigi)
 			}
+		} else {
+			/* Normal (non-message) case. */
+			if s_debug >= 2 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("ig_to_tx_allow? NO. Duplicate sent %d seconds ago. bydigi=%d\n", int(time.Since(entry.time_stamp).Seconds()), entry.bydigi)
+			}
+
+			text_color_set(DW_COLOR_INFO)
+			dw_printf("Tx IGate: Drop duplicate packet transmitted recently.\n")
+
+			return false
 		}
 	}
 
@@ -140,6 +140,10 @@ type kissport_status_s struct {
 
 	client_sock [MAX_NET_CLIENTS]net.Conn
 
+	client_queue [MAX_NET_CLIENTS]*clientQueue
+	/* Bounded outbound queue with its own writer goroutine so a */
+	/* stalled client can't block the fan-out path.  See client_queue.go. */
+
 	kf [MAX_NET_CLIENTS]*KISSFrame
 	/* Accumulated KISS frame and state of decoder. */
 }
@@ -200,26 +204,41 @@ func kiss_frame_init(pa *audio_s) {
  *-----------------------------------------------------------------*/
 
 func KissEncapsulate(in []byte) []byte {
-	var buf bytes.Buffer
+	// Copy whole spans between the characters needing escapes rather
+	// than examining every byte individually.  Most frames contain few
+	// or no FEND/FESC bytes so this is usually two big copies.
 
-	buf.WriteByte(FEND)
+	var out = make([]byte, 0, len(in)+2)
 
-	for _, b := range in {
-		switch b {
-		case FEND:
-			buf.WriteByte(FESC)
-			buf.WriteByte(TFEND)
-		case FESC:
-			buf.WriteByte(FESC)
-			buf.WriteByte(TFESC)
-		default:
-			buf.WriteByte(b)
+	out = append(out, FEND)
+
+	for len(in) > 0 {
+		var i = bytes.IndexByte(in, FEND)
+
+		var iesc = bytes.IndexByte(in, FESC)
+		if i < 0 || (iesc >= 0 && iesc < i) {
+			i = iesc
+		}
+
+		if i < 0 {
+			out = append(out, in...)
+			break
+		}
+
+		out = append(out, in[:i]...)
+
+		if in[i] == FEND {
+			out = append(out, FESC, TFEND)
+		} else {
+			out = append(out, FESC, TFESC)
 		}
+
+		in = in[i+1:]
 	}
 
-	buf.WriteByte(FEND)
+	out = append(out, FEND)
 
-	return buf.Bytes()
+	return out
 }
 
 /*-------------------------------------------------------------------
@@ -270,35 +289,64 @@ func kiss_unwrap(in []byte) []byte {
 		in = in[1:] // Skip over optional leading FEND
 	}
 
-	var escapedMode = false
-	var buf bytes.Buffer
+	// Copy whole spans between FESC characters rather than examining
+	// every byte individually.  Stray FENDs in the middle still get
+	// the diagnostic but are passed through, same as before.
+
+	var out = make([]byte, 0, len(in))
+
+	for len(in) > 0 {
+		var i = bytes.IndexByte(in, FESC)
+
+		var span = in
+		if i >= 0 {
+			span = in[:i]
+		}
+
+		for rest := span; ; {
+			var j = bytes.IndexByte(rest, FEND)
+			if j < 0 {
+				break
+			}
 
-	for _, b := range in {
-		if b == FEND {
 			text_color_set(DW_COLOR_ERROR)
 			dw_printf("KISS frame should not have FEND in the middle.\n")
+			rest = rest[j+1:]
 		}
 
-		if escapedMode {
-			switch b {
-			case TFESC:
-				buf.WriteByte(FESC)
-			case TFEND:
-				buf.WriteByte(FEND)
-			default:
-				text_color_set(DW_COLOR_ERROR)
-				dw_printf("KISS protocol error.  Found 0x%02x after FESC.\n", b)
-			}
+		out = append(out, span...)
 
-			escapedMode = false
-		} else if b == FESC {
-			escapedMode = true
-		} else {
-			buf.WriteByte(b)
+		if i < 0 {
+			break
 		}
+
+		// Process the escape sequence.
+
+		if i+1 >= len(in) {
+			// FESC was the last byte.  The old byte-at-a-time version
+			// quietly did nothing with a dangling escape.
+			break
+		}
+
+		switch in[i+1] {
+		case TFESC:
+			out = append(out, FESC)
+		case TFEND:
+			out = append(out, FEND)
+		case FEND:
+			text_color_set(DW_COLOR_ERROR)
+			dw_printf("KISS frame should not have FEND in the middle.\n")
+			text_color_set(DW_COLOR_ERROR)
+			dw_printf("KISS protocol error.  Found 0x%02x after FESC.\n", in[i+1])
+		default:
+			text_color_set(DW_COLOR_ERROR)
+			dw_printf("KISS protocol error.  Found 0x%02x after FESC.\n", in[i+1])
+		}
+
+		in = in[i+2:]
 	}
 
-	return buf.Bytes()
+	return out
 } /* end kiss_unwrap */
 
 /*-------------------------------------------------------------------
@@ -501,6 +549,90 @@ func KissRecByte(kf *KISSFrame, ch byte, debug int,
 	}
 } /* end KissRecByte */
 
+/*-------------------------------------------------------------------
+ *
+ * Name:        KissRecBytes
+ *
+ * Purpose:     Process a whole chunk of bytes from a KISS client app.
+ *
+ * Inputs:	Same as KissRecByte but with a buffer instead of one byte.
+ *
+ * Outputs:	kf	- Current state is updated.
+ *
+ * Description:	Equivalent to calling KissRecByte for each byte but
+ *		frame contents are located with bytes.IndexByte and
+ *		copied span at a time.  A high rate client delivering
+ *		several frames per TCP read costs a few scans and copies
+ *		instead of a function call per byte.
+ *
+ *		The interesting bytes (FEND ending a frame, noise before
+ *		one) still go through KissRecByte so the frame completion
+ *		and command-mode appeasement logic exists in one place.
+ *
+ *-----------------------------------------------------------------*/
+
+func KissRecBytes(kf *KISSFrame, buf []byte, debug int,
+	kps *kissport_status_s, client int,
+	sendfun kiss_sendfun) {
+	for len(buf) > 0 {
+		if kf.state != KS_COLLECTING {
+			// Searching for the starting FEND.  Anything before it is
+			// noise, which is rare and has per-byte logic (command-mode
+			// detection on carriage return), so take the slow path to
+			// just before the FEND.
+
+			var i = bytes.IndexByte(buf, FEND)
+
+			var limit = len(buf)
+			if i >= 0 {
+				limit = i + 1 // Include the FEND to enter frame collection.
+			}
+
+			for k := range limit {
+				KissRecByte(kf, buf[k], debug, kps, client, sendfun)
+			}
+
+			buf = buf[limit:]
+
+			continue
+		}
+
+		// Collecting a frame.  Copy everything up to the ending FEND
+		// in one go.
+
+		var i = bytes.IndexByte(buf, FEND)
+
+		var span = buf
+		if i >= 0 {
+			span = buf[:i]
+		}
+
+		if len(span) > 0 {
+			var ncopy = len(span)
+			if kf.kiss_len+ncopy > MAX_KISS_LEN {
+				ncopy = MAX_KISS_LEN - kf.kiss_len
+
+				text_color_set(DW_COLOR_ERROR)
+				dw_printf("KISS message exceeded maximum length.\n")
+			}
+
+			copy(kf.kiss_msg[kf.kiss_len:], span[:ncopy])
+			kf.kiss_len += ncopy
+		}
+
+		if i < 0 {
+			return
+		}
+
+		// Hand the FEND to the per-byte function which knows how to
+		// finish (or restart) the frame.
+
+		KissRecByte(kf, FEND, debug, kps, client, sendfun)
+
+		buf = buf[i+1:]
+	}
+} /* end KissRecBytes */
+
 /*-------------------------------------------------------------------
  *
  * Name:        kiss_process_msg
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"bytes"
+	"testing"
+)
+
+// The span-scanning KissRecBytes must leave the collector in exactly
+// the same state as feeding the same bytes through KissRecByte one at
+// a time, for any chunking of the input.  The final FEND is withheld
+// so the frame stays in the collector where we can compare it.
+
+func TestKissRecBytesMatchesPerByte(t *testing.T) {
+	var payloads = [][]byte{
+		[]byte("\x00plain data with no special bytes"),
+		{0x00, FEND, 0x01, FESC, 0x02, FEND, FEND, 0x03},
+		{0x00, FESC, FESC, FEND},
+		bytes.Repeat([]byte{0x55, FEND}, 300),
+	}
+
+	var sendfun = func(int, int, []byte, int, *kissport_status_s, int) {}
+
+	for _, payload := range payloads {
+		var wire = KissEncapsulate(payload)
+		wire = wire[:len(wire)-1] // Withhold final FEND so nothing is processed.
+
+		// Some leading noise to exercise the searching state too.
+		var input = append([]byte("noise"), wire...)
+
+		var reference = new(KISSFrame)
+		for _, b := range input {
+			KissRecByte(reference, b, 0, nil, -1, sendfun)
+		}
+
+		for _, chunkSize := range []int{1, 3, 7, len(input)} {
+			var batched = new(KISSFrame)
+
+			for start := 0; start < len(input); start += chunkSize {
+				var end = min(start+chunkSize, len(input))
+				KissRecBytes(batched, input[start:end], 0, nil, -1, sendfun)
+			}
+
+			if batched.state != reference.state {
+				t.Errorf("chunk size %d: state %d, want %d", chunkSize, batched.state, reference.state)
+			}
+
+			if batched.kiss_len != reference.kiss_len {
+				t.Errorf("chunk size %d: kiss_len %d, want %d", chunkSize, batched.kiss_len, reference.kiss_len)
+			}
+
+			if !bytes.Equal(batched.kiss_msg[:batched.kiss_len], reference.kiss_msg[:reference.kiss_len]) {
+				t.Errorf("chunk size %d: collected frame differs from per-byte result", chunkSize)
+			}
+		}
+	}
+}
+
+// Escape handling details that the round-trip test can't see.
+
+func TestKissUnwrapEscapes(t *testing.T) {
+	var cases = []struct {
+		name string
+		in   []byte
+		want []byte
+	}{
+		{"escaped fend", []byte{FEND, 0x00, FESC, TFEND, 0x01, FEND}, []byte{0x00, FEND, 0x01}},
+		{"escaped fesc", []byte{FEND, 0x00, FESC, TFESC, 0x01, FEND}, []byte{0x00, FESC, 0x01}},
+		{"bad escape dropped", []byte{FEND, 0x00, FESC, 0x42, 0x01, FEND}, []byte{0x00, 0x01}},
+	}
+
+	for _, c := range cases {
+		var got = kiss_unwrap(c.in)
+		if !bytes.Equal(got, c.want) {
+			t.Errorf("%s: got % x, want % x", c.name, got, c.want)
+		}
+	}
+}
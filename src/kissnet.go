@@ -250,11 +250,23 @@ func (kns *KissNetService) SendRecPacket(channel int, kiss_cmd int, fbuf []byte,
 	// However, there are times we want to send a response only to a particular client.
 	// In the case of a serial port or pseudo terminal, there is only one potential client.
 	// so the response would be sent to only one place.  A new parameter has been added for this.
+
+	// The encapsulated frame is identical for every client except for the
+	// channel nibble in the header byte, which has only two possible values:
+	// the radio channel (ports carrying all channels) or zero (ports carrying
+	// this single channel).  Build each variant at most once and hand every
+	// matching client the same buffer for a single socket write, instead of
+	// re-copying and re-escaping the frame per client.
+
+	var all_chan_buff []byte
+	var single_chan_buff []byte
+
 	for kps := kns.allPorts; kps != nil; kps = kps.pnext {
 		if onlykps == nil || kps == onlykps {
 			for client := range MAX_NET_CLIENTS {
 				if onlyclient == -1 || client == onlyclient {
-					if kps.client_sock[client] != nil {
+					var q = kps.client_queue[client]
+					if q != nil {
 						var kiss_buff []byte
 
 						if flen < 0 {
@@ -275,8 +287,6 @@ func (kns *KissNetService) SendRecPacket(channel int, kiss_cmd int, fbuf []byte,
 
 							kiss_buff = fbuf
 						} else {
-							var stemp []byte
-
 							// New in 1.7.
 							// Previously all channels were sent to everyone.
 							// We now have tcp ports which carry only a single radio channel.
@@ -284,27 +294,23 @@ func (kns *KissNetService) SendRecPacket(channel int, kiss_cmd int, fbuf []byte,
 
 							if kps.channel == -1 { //nolint:staticcheck
 								// Normal case, all channels.
-								stemp = []byte{byte((channel << 4) | kiss_cmd)}
+								if all_chan_buff == nil {
+									all_chan_buff = kns.encapsulateRecPacket(byte((channel<<4)|kiss_cmd), fbuf)
+								}
+
+								kiss_buff = all_chan_buff
 							} else if kps.channel == channel {
 								// Single radio channel for this port.  Application sees 0.
-								stemp = []byte{byte((0 << 4) | kiss_cmd)}
+								if single_chan_buff == nil {
+									single_chan_buff = kns.encapsulateRecPacket(byte((0<<4)|kiss_cmd), fbuf)
+								}
+
+								kiss_buff = single_chan_buff
 							} else {
 								// Skip it.
 								continue
 							}
 
-							stemp = append(stemp, fbuf...)
-
-							if kns.debug >= 2 {
-								/* AX.25 frame with the CRC removed. */
-								text_color_set(DW_COLOR_DEBUG)
-								dw_printf("\n")
-								dw_printf("Packet content before adding KISS framing and any escapes:\n")
-								HexDump(fbuf)
-							}
-
-							kiss_buff = KissEncapsulate(stemp)
-
 							/* This has the escapes and the surrounding FENDs. */
 
 							if kns.debug > 0 {
@@ -312,13 +318,10 @@ func (kns *KissNetService) SendRecPacket(channel int, kiss_cmd int, fbuf []byte,
 							}
 						}
 
-						var _, err = kps.client_sock[client].Write(kiss_buff)
-						if err != nil {
-							text_color_set(DW_COLOR_ERROR)
-							dw_printf("\nError %s sending message to KISS client application %d on port %d.  Closing connection.\n\n", err, client, kps.tcp_port)
-							kps.client_sock[client].Close()
-							kps.client_sock[client] = nil
-						}
+						// Non-blocking: a stalled client drops messages
+						// and is eventually evicted rather than holding
+						// up this loop for the other clients.
+						q.Send(kiss_buff)
 					} // frame length >= 0
 				} // if all clients or the one specifie
 			} // for each client on the tcp port
@@ -326,6 +329,26 @@ func (kns *KissNetService) SendRecPacket(channel int, kiss_cmd int, fbuf []byte,
 	} // for each tcp port
 } /* end SendRecPacket */
 
+// Prepend the channel/command header byte and apply KISS framing.
+// Done at most once per header variant for each received frame;
+// the result is shared by all clients it is sent to.
+
+func (kns *KissNetService) encapsulateRecPacket(header byte, fbuf []byte) []byte {
+	var stemp = make([]byte, 0, len(fbuf)+1)
+	stemp = append(stemp, header)
+	stemp = append(stemp, fbuf...)
+
+	if kns.debug >= 2 {
+		/* AX.25 frame with the CRC removed. */
+		text_color_set(DW_COLOR_DEBUG)
+		dw_printf("\n")
+		dw_printf("Packet content before adding KISS framing and any escapes:\n")
+		HexDump(fbuf)
+	}
+
+	return KissEncapsulate(stemp)
+}
+
 /*-------------------------------------------------------------------
  *
  * Name:        Copy
@@ -367,7 +390,8 @@ func (kns *KissNetService) Copy(_msg []byte, channel int, cmd int, from_kps *kis
 			for client := range MAX_NET_CLIENTS {
 				// To all but origin.
 				if !(kps == from_kps && client == from_client) {
-					if kps.client_sock[client] != nil {
+					var q = kps.client_queue[client]
+					if q != nil {
 						if kps.channel == -1 || kps.channel == channel {
 							// Two different cases here:
 							//  - The TCP port allows all channels, or
@@ -386,13 +410,7 @@ func (kns *KissNetService) Copy(_msg []byte, channel int, cmd int, from_kps *kis
 								kiss_debug_print(TO_CLIENT, "", kiss_buff)
 							}
 
-							var _, err = kps.client_sock[client].Write(kiss_buff)
-							if err != nil {
-								text_color_set(DW_COLOR_ERROR)
-								dw_printf("\nError %s copying message to KISS TCP port %d client %d application.  Closing connection.\n\n", err, kps.tcp_port, client)
-								kps.client_sock[client].Close()
-								kps.client_sock[client] = nil
-							}
+							q.Send(kiss_buff)
 						} // Channel is allowed on this port.
 					} // socket is open
 				} // if origin and destination different.
@@ -417,21 +435,23 @@ func (kns *KissNetService) Copy(_msg []byte, channel int, cmd int, from_kps *kis
  *
  *--------------------------------------------------------------------*/
 
-/* Return one byte (value 0 - 255) */
+/* Return a chunk of whatever is available, at least one byte. */
 
-func (kns *KissNetService) get(kps *kissport_status_s, client int) byte {
+func (kns *KissNetService) get(kps *kissport_status_s, client int) []byte {
 	for {
 		for kps.client_sock[client] == nil {
 			SLEEP_SEC(1) /* Not connected.  Try again later. */
 		}
 
-		/* Just get one byte at a time. */
+		/* Grab as much as is available rather than a byte at a time. */
+		/* KissRecBytes scans it in spans so a fast client pumping */
+		/* multiple frames per read does not cost a call per byte. */
 
 		var c = kps.client_sock[client]
-		var ch = make([]byte, 1)
+		var ch = make([]byte, 4096)
 		var n, _ = c.Read(ch)
 
-		if n == 1 {
+		if n > 0 {
 			/* TODO KG
 			#if DEBUG9
 				    dw_printf (log_fp, "%02x %c %c", ch,
@@ -447,14 +467,19 @@ func (kns *KissNetService) get(kps *kissport_status_s, client int) byte {
 				    if (ch == FEND) fflush (log_fp);
 			#endif
 			*/
-			return (ch[0])
+			return (ch[:n])
 		}
 
 		text_color_set(DW_COLOR_ERROR)
 		dw_printf("\nKISS client application %d on TCP port %d has gone away.\n\n", client, kps.tcp_port)
-		c.Close()
 
-		kps.client_sock[client] = nil
+		var q = kps.client_queue[client]
+		if q != nil {
+			q.Evict("") // Also closes socket and stops the writer goroutine.
+		} else {
+			c.Close()
+			kps.client_sock[client] = nil
+		}
 	}
 }
 
@@ -480,8 +505,8 @@ func (kns *KissNetService) listenThread(kps *kissport_status_s, client int) {
 	// "Simply KISS" as some call it.
 
 	for {
-		var ch = kns.get(kps, client)
-		KissRecByte(kps.kf[client], ch, kns.debug, kps, client, kns.SendRecPacket)
+		var chunk = kns.get(kps, client)
+		KissRecBytes(kps.kf[client], chunk, kns.debug, kps, client, kns.SendRecPacket)
 	}
 } /* end listenThread */
 
@@ -597,6 +622,15 @@ func (kns *KissNetService) connectListenThread(kps *kissport_status_s) {
 				continue
 			}
 
+			kps.client_queue[client] = newClientQueue(conn, func(reason string) {
+				if reason != "" {
+					text_color_set(DW_COLOR_ERROR)
+					dw_printf("\n%s\nClosing connection to KISS TCP client application %d on port %d.\n\n", reason, client, kps.tcp_port)
+				}
+
+				kps.client_queue[client] = nil
+				kps.client_sock[client] = nil
+			})
 			kps.client_sock[client] = conn
 
 			text_color_set(DW_COLOR_INFO)
@@ -30,12 +30,29 @@ import (
 	"unicode"
 )
 
+// How many formatted records can be waiting for the writer goroutine.
+// When storage stalls long enough to fill this, further records are
+// counted and discarded rather than blocking packet processing.
+const LOG_QUEUE_DEPTH = 256
+
+// One line of the CSV file, formatted in the caller's goroutine but
+// not yet written.  The timestamp drives the daily file rollover.
+type logRecord struct {
+	when time.Time
+	row  []string
+}
+
 type PacketLogger struct {
-	mu         sync.Mutex // Guards the fields below, since Write/Close may be called from multiple goroutines (e.g. beacon and main receive loop).
-	dailyNames bool       // True if daily names should be generated. In this case path is a directory.
-	logPath    string     // Save directory or full name here for later use.
-	logFp      *os.File   // File pointer for writing. Note that file is kept open. We don't open/close for every new item.
-	openFname  string     // Name of currently open file. Applicable only when dailyNames is true.
+	mu         sync.Mutex     // Guards the fields below, since Write/Close may be called from multiple goroutines (e.g. beacon and main receive loop).
+	dailyNames bool           // True if daily names should be generated. In this case path is a directory.
+	logPath    string         // Save directory or full name here for later use.
+	logFp      *os.File       // File pointer for writing. Note that file is kept open. We don't open/close for every new item.
+	openFname  string         // Name of currently open file. Applicable only when dailyNames is true.
+	queue      chan logRecord // Formatted records waiting to be written.  nil when logging is disabled.
+	quit       chan struct{}  // Closed by Close to tell the writer goroutine to drain and stop.
+	done       chan struct{}  // Closed by the writer goroutine after it has drained the queue and closed the file.
+	closed     bool           // Close has been called; don't close the queue twice.
+	dropped    int            // Records discarded because the queue was full.
 }
 
 /*-------------------------------------------------------------------
@@ -105,6 +122,14 @@ func NewPacketLogger(daily_names bool, path string) *PacketLogger {
 		pl.logPath = path
 	}
 
+	// All file I/O happens on a dedicated goroutine so a slow SD card
+	// can never stall the receive processing path.
+
+	pl.queue = make(chan logRecord, LOG_QUEUE_DEPTH)
+	pl.quit = make(chan struct{})
+	pl.done = make(chan struct{})
+	go pl.writerLoop()
+
 	return pl
 } /* end NewPacketLogger */
 
@@ -128,14 +153,50 @@ func NewPacketLogger(daily_names bool, path string) *PacketLogger {
 
 func (pl *PacketLogger) Write(channel int, A *decode_aprs_t, pp *packet_t, alevel ALevel, retries BitFixLevel) {
 	pl.mu.Lock()
-	defer pl.mu.Unlock()
+	var enabled = len(pl.logPath) > 0 && !pl.closed
+	pl.mu.Unlock()
 
-	if len(pl.logPath) == 0 {
+	if !enabled {
 		return
 	}
 
 	var now = time.Now().UTC()
 
+	// Format here, in the caller's goroutine, because pp may be reused
+	// as soon as we return.  Only the file I/O is deferred to the
+	// writer goroutine, so a stalling SD card can't stall us.
+
+	var rec = logRecord{when: now, row: formatLogRecord(channel, A, pp, alevel, retries, now)}
+
+	select {
+	case pl.queue <- rec:
+	default:
+		// The writer has been stuck long enough to fill the queue.
+		// Dropping a log record is better than delaying the dlq.
+		pl.mu.Lock()
+		pl.dropped++
+		pl.mu.Unlock()
+	}
+} /* end Write */
+
+/*-------------------------------------------------------------------
+ *
+ * Name:        ensureOpenLocked
+ *
+ * Purpose:	Make sure the log file for the given time is open,
+ *		handling the daily rollover.  Caller must hold pl.mu.
+ *
+ * Inputs:	now	- Timestamp of the record about to be written.
+ *
+ * Returns:	True if pl.logFp is open and ready for writing.
+ *
+ *--------------------------------------------------------------------*/
+
+func (pl *PacketLogger) ensureOpenLocked(now time.Time) bool {
+	if len(pl.logPath) == 0 {
+		return false
+	}
+
 	if pl.dailyNames {
 		// Original strategy.  Automatic daily file names.
 
@@ -177,7 +238,7 @@ func (pl *PacketLogger) Write(channel int, A *decode_aprs_t, pp *packet_t, aleve
 
 				pl.openFname = ""
 
-				return
+				return false
 			}
 
 			// Write a header suitable for importing into a spreadsheet
@@ -210,7 +271,7 @@ func (pl *PacketLogger) Write(channel int, A *decode_aprs_t, pp *packet_t, aleve
 
 				pl.logPath = ""
 
-				return
+				return false
 			}
 
 			// Write a header suitable for importing into a spreadsheet
@@ -222,106 +283,228 @@ func (pl *PacketLogger) Write(channel int, A *decode_aprs_t, pp *packet_t, aleve
 		}
 	}
 
-	// Add line to file if it is now open.
+	return pl.logFp != nil
+} /* end ensureOpenLocked */
 
-	if pl.logFp != nil {
-		var itime = now.Format("2006-01-02T15:04:05Z")
+/*-------------------------------------------------------------------
+ *
+ * Name:        formatLogRecord
+ *
+ * Purpose:	Turn one received packet into the fields of a CSV line.
+ *		Pure formatting; no I/O, no shared state.
+ *
+ * Inputs:	Same as Write, plus the timestamp to use.
+ *
+ * Returns:	Field values matching the header written by
+ *		ensureOpenLocked.
+ *
+ *--------------------------------------------------------------------*/
 
-		/* Who are we hearing?   Original station or digipeater? */
-		/* Similar code in direwolf.c.  Combine into one function? */
+func formatLogRecord(channel int, A *decode_aprs_t, pp *packet_t, alevel ALevel, retries BitFixLevel, now time.Time) []string {
+	var itime = now.Format("2006-01-02T15:04:05Z")
 
-		var heard = ""
-		var h int
+	/* Who are we hearing?   Original station or digipeater? */
+	/* Similar code in direwolf.c.  Combine into one function? */
 
-		if pp != nil {
-			if ax25_get_num_addr(pp) == 0 {
-				/* Not AX.25. No station to display below. */
-				h = -1
-			} else {
-				h = ax25_get_heard(pp)
-				heard = ax25_get_addr_with_ssid(pp, h)
-			}
+	var heard = ""
+	var h int
 
-			if h >= AX25_REPEATER_2 &&
-				len(heard) == 5 &&
-				heard[:4] == "WIDE" &&
-				unicode.IsDigit(rune(heard[4])) {
-				heard = ax25_get_addr_with_ssid(pp, h-1) + "?"
-			}
+	if pp != nil {
+		if ax25_get_num_addr(pp) == 0 {
+			/* Not AX.25. No station to display below. */
+			h = -1
+		} else {
+			h = ax25_get_heard(pp)
+			heard = ax25_get_addr_with_ssid(pp, h)
 		}
 
-		var alevel_text = ax25_alevel_to_text(alevel)
-
-		var sdti string
-		if pp != nil {
-			sdti = string(rune(ax25_get_dti(pp)))
+		if h >= AX25_REPEATER_2 &&
+			len(heard) == 5 &&
+			heard[:4] == "WIDE" &&
+			unicode.IsDigit(rune(heard[4])) {
+			heard = ax25_get_addr_with_ssid(pp, h-1) + "?"
 		}
+	}
 
-		var sname = A.g_src
-		if len(A.g_name) > 0 {
-			sname = A.g_name
-		}
+	var alevel_text = ax25_alevel_to_text(alevel)
 
-		var ssymbol = string(rune(A.g_symbol_table)) + string(rune(A.g_symbol_code))
+	var sdti string
+	if pp != nil {
+		sdti = string(rune(ax25_get_dti(pp)))
+	}
 
-		var smfr = A.g_mfr
-		var sstatus = A.g_mic_e_status
-		var stelemetry = A.g_telemetry
-		var scomment = A.g_comment
+	var sname = A.g_src
+	if len(A.g_name) > 0 {
+		sname = A.g_name
+	}
 
-		var slat = ""
-		if A.g_lat != G_UNKNOWN {
-			slat = fmt.Sprintf("%.6f", A.g_lat)
-		}
+	var ssymbol = string(rune(A.g_symbol_table)) + string(rune(A.g_symbol_code))
 
-		var slon = ""
-		if A.g_lon != G_UNKNOWN {
-			slon = fmt.Sprintf("%.6f", A.g_lon)
-		}
+	var smfr = A.g_mfr
+	var sstatus = A.g_mic_e_status
+	var stelemetry = A.g_telemetry
+	var scomment = A.g_comment
 
-		var sspd = ""
-		if A.g_speed_mph != G_UNKNOWN {
-			sspd = fmt.Sprintf("%.1f", DW_MPH_TO_KNOTS(float64(A.g_speed_mph)))
-		}
+	var slat = ""
+	if A.g_lat != G_UNKNOWN {
+		slat = fmt.Sprintf("%.6f", A.g_lat)
+	}
 
-		var scse = ""
-		if A.g_course != G_UNKNOWN {
-			scse = fmt.Sprintf("%.1f", A.g_course)
-		}
+	var slon = ""
+	if A.g_lon != G_UNKNOWN {
+		slon = fmt.Sprintf("%.6f", A.g_lon)
+	}
 
-		var salt = ""
-		if A.g_altitude_ft != G_UNKNOWN {
-			salt = fmt.Sprintf("%.1f", DW_FEET_TO_METERS(float64(A.g_altitude_ft)))
-		}
+	var sspd = ""
+	if A.g_speed_mph != G_UNKNOWN {
+		sspd = fmt.Sprintf("%.1f", DW_MPH_TO_KNOTS(float64(A.g_speed_mph)))
+	}
+
+	var scse = ""
+	if A.g_course != G_UNKNOWN {
+		scse = fmt.Sprintf("%.1f", A.g_course)
+	}
+
+	var salt = ""
+	if A.g_altitude_ft != G_UNKNOWN {
+		salt = fmt.Sprintf("%.1f", DW_FEET_TO_METERS(float64(A.g_altitude_ft)))
+	}
+
+	var sfreq = ""
+	if A.g_freq != G_UNKNOWN {
+		sfreq = fmt.Sprintf("%.3f", A.g_freq)
+	}
+
+	var soffs = ""
+	if A.g_offset != G_UNKNOWN {
+		soffs = fmt.Sprintf("%+d", A.g_offset)
+	}
+
+	var stone = ""
+	if A.g_tone != G_UNKNOWN {
+		stone = fmt.Sprintf("%.1f", A.g_tone)
+	}
+
+	if A.g_dcs != G_UNKNOWN {
+		stone = fmt.Sprintf("D%03o", A.g_dcs)
+	}
+
+	return []string{
+		strconv.Itoa(channel), strconv.Itoa(int(now.Unix())), itime,
+		A.g_src, heard, alevel_text, strconv.Itoa(int(retries)), sdti,
+		sname, ssymbol,
+		slat, slon, sspd, scse, salt,
+		sfreq, soffs, stone,
+		smfr, sstatus, stelemetry, scomment,
+	}
+} /* end formatLogRecord */
+
+/*-------------------------------------------------------------------
+ *
+ * Name:        writerLoop
+ *
+ * Purpose:	Dedicated goroutine that does all the log file I/O.
+ *
+ * Description:	Records that arrived while a previous write was in
+ *		progress are coalesced into a single append, so a burst
+ *		of packets costs one trip to storage rather than one
+ *		per packet.  Runs until Close signals via pl.quit, then
+ *		drains whatever is left and closes the file.
+ *
+ *--------------------------------------------------------------------*/
+
+func (pl *PacketLogger) writerLoop() {
+	var batch []logRecord
+
+	for {
+		select {
+		case rec := <-pl.queue:
+			batch = append(batch[:0], rec)
+
+			// Pick up anything else already waiting.
+		drain:
+			for len(batch) < LOG_QUEUE_DEPTH {
+				select {
+				case more := <-pl.queue:
+					batch = append(batch, more)
+				default:
+					break drain
+				}
+			}
+
+			pl.writeBatch(batch)
+
+		case <-pl.quit:
+			// Final drain before closing the file.
+			batch = batch[:0]
+		final:
+			for {
+				select {
+				case rec := <-pl.queue:
+					batch = append(batch, rec)
+				default:
+					break final
+				}
+			}
 
-		var sfreq = ""
-		if A.g_freq != G_UNKNOWN {
-			sfreq = fmt.Sprintf("%.3f", A.g_freq)
+			pl.writeBatch(batch)
+
+			pl.mu.Lock()
+			if pl.dropped > 0 {
+				text_color_set(DW_COLOR_ERROR)
+				dw_printf("Discarded %d log records because the log file could not keep up.\n", pl.dropped)
+			}
+			pl.closeLocked()
+			pl.mu.Unlock()
+
+			close(pl.done)
+			return
 		}
+	}
+} /* end writerLoop */
+
+/*-------------------------------------------------------------------
+ *
+ * Name:        writeBatch
+ *
+ * Purpose:	Append a batch of formatted records to the log file,
+ *		opening or rolling it over as needed.
+ *
+ * Inputs:	batch	- Records in arrival order.
+ *
+ *--------------------------------------------------------------------*/
+
+func (pl *PacketLogger) writeBatch(batch []logRecord) {
+	if len(batch) == 0 {
+		return
+	}
 
-		var soffs = ""
-		if A.g_offset != G_UNKNOWN {
-			soffs = fmt.Sprintf("%+d", A.g_offset)
+	pl.mu.Lock()
+	defer pl.mu.Unlock()
+
+	var w *csv.Writer
+
+	for _, rec := range batch {
+		// Flush before a daily rollover so nothing buffered is lost
+		// when the old file is closed.
+
+		if pl.dailyNames && w != nil && rec.when.Format("2006-01-02.log") != pl.openFname {
+			w.Flush()
+			w = nil
 		}
 
-		var stone = ""
-		if A.g_tone != G_UNKNOWN {
-			stone = fmt.Sprintf("%.1f", A.g_tone)
+		if !pl.ensureOpenLocked(rec.when) {
+			continue
 		}
 
-		if A.g_dcs != G_UNKNOWN {
-			stone = fmt.Sprintf("D%03o", A.g_dcs)
+		if w == nil {
+			w = csv.NewWriter(pl.logFp)
 		}
 
-		var w = csv.NewWriter(pl.logFp)
-		w.Write([]string{
-			strconv.Itoa(channel), strconv.Itoa(int(now.Unix())), itime,
-			A.g_src, heard, alevel_text, strconv.Itoa(int(retries)), sdti,
-			sname, ssymbol,
-			slat, slon, sspd, scse, salt,
-			sfreq, soffs, stone,
-			smfr, sstatus, stelemetry, scomment,
-		})
+		w.Write(rec.row)
+	}
+
+	if w != nil {
 		w.Flush()
 
 		var writeError = w.Error()
@@ -329,7 +512,7 @@ func (pl *PacketLogger) Write(channel int, A *decode_aprs_t, pp *packet_t, aleve
 			dw_printf("CSV write error: %s", writeError)
 		}
 	}
-} /* end Write */
+} /* end writeBatch */
 
 /*-------------------------------------------------------------------
  *
@@ -394,18 +577,45 @@ func (pl *PacketLogger) RRBits(A *decode_aprs_t, pp *packet_t) {
  *
  * Name:        Close
  *
- * Purpose:	Close any open log file.
- *		Called when exiting or when date changes.
+ * Purpose:	Flush any queued records, stop the writer goroutine,
+ *		and close any open log file.  Called when exiting.
  *
  *------------------------------------------------------------------*/
 
 func (pl *PacketLogger) Close() {
 	pl.mu.Lock()
-	defer pl.mu.Unlock()
 
-	pl.closeLocked()
+	if pl.queue == nil || pl.closed {
+		// Logging was never enabled, or already closed.
+		pl.closeLocked()
+		pl.mu.Unlock()
+
+		return
+	}
+
+	pl.closed = true
+	pl.mu.Unlock()
+
+	close(pl.quit)
+	<-pl.done
 } /* end Close */
 
+/*-------------------------------------------------------------------
+ *
+ * Name:        Dropped
+ *
+ * Purpose:	Number of log records discarded because storage could
+ *		not keep up.
+ *
+ *------------------------------------------------------------------*/
+
+func (pl *PacketLogger) Dropped() int {
+	pl.mu.Lock()
+	defer pl.mu.Unlock()
+
+	return pl.dropped
+} /* end Dropped */
+
 // closeLocked does the work of Close, assuming pl.mu is already held.
 func (pl *PacketLogger) closeLocked() {
 	if pl.logFp != nil {
@@ -3,7 +3,12 @@
 
 package direwolf
 
-import "testing"
+import (
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
 
 // Regression test for a bug where heard[:4] and heard[4] were indexed
 // before checking len(heard) == 5, causing a panic whenever the heard
@@ -25,3 +30,48 @@ func TestLogRRBitsShortHeardDoesNotPanic(t *testing.T) {
 	var pl = NewPacketLogger(false, "")
 	pl.RRBits(&A, pp)
 }
+
+// Records queued before Close must all reach the file, in order, even
+// though the actual writing happens on the writer goroutine.
+func TestPacketLoggerAsyncWriteClose(t *testing.T) {
+	t.Parallel()
+
+	var path = filepath.Join(t.TempDir(), "test.log")
+
+	var pl = NewPacketLogger(false, path)
+
+	var A decode_aprs_t
+	A.g_src = "Q1TEST"
+
+	var alevel ALevel
+
+	for range 3 {
+		pl.Write(0, &A, nil, alevel, 0)
+	}
+
+	pl.Close()
+
+	var contents, readErr = os.ReadFile(path)
+	if readErr != nil {
+		t.Fatalf("reading log file: %s", readErr)
+	}
+
+	var lines = strings.Split(strings.TrimRight(string(contents), "\n"), "\n")
+	if len(lines) != 4 {
+		t.Fatalf("got %d lines, want header plus 3 records", len(lines))
+	}
+
+	if !strings.HasPrefix(lines[0], "chan,utime,") {
+		t.Errorf("missing header line: %q", lines[0])
+	}
+
+	for _, line := range lines[1:] {
+		if !strings.Contains(line, "Q1TEST") {
+			t.Errorf("record line missing source callsign: %q", line)
+		}
+	}
+
+	if pl.Dropped() != 0 {
+		t.Errorf("unexpected dropped records: %d", pl.Dropped())
+	}
+}
@@ -0,0 +1,299 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+//nolint:gochecknoglobals
+package direwolf
+
+/*------------------------------------------------------------------
+ *
+ * Purpose:   	Lightweight always-on runtime metrics.
+ *
+ * Description:	Counters, gauges, and latency histograms for the hot
+ *		paths: received frame queue depth and wait time,
+ *		transmit queue backlog, retry-fix attempts, pool and
+ *		cache effectiveness.  The instruments are cheap enough
+ *		(an atomic add, or nothing at all for gauges which are
+ *		only sampled when read) to leave enabled unconditionally.
+ *
+ *		Two optional ways to look at them:
+ *
+ *		METRICSPORT n	- Serve a plain text dump over HTTP at
+ *				  http://localhost:n/metrics
+ *
+ *		METRICSTIME n	- Print the same dump to the console
+ *				  every n seconds, in the same spirit
+ *				  as the periodic audio statistics.
+ *
+ *---------------------------------------------------------------*/
+
+import (
+	"fmt"
+	"net/http"
+	"sort"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+/*
+ * A counter only ever goes up.  Hot paths keep a pointer so each
+ * event is a single atomic add.
+ */
+
+type metrics_counter_t struct {
+	name string
+	val  atomic.Int64
+}
+
+func (c *metrics_counter_t) incr() {
+	c.val.Add(1)
+}
+
+func (c *metrics_counter_t) add(n int64) {
+	c.val.Add(n)
+}
+
+/*
+ * Histogram bucket upper bounds, in milliseconds, for latencies.
+ * One extra bucket catches everything beyond the last bound.
+ */
+
+var metrics_histogram_bounds_ms = []int64{1, 2, 5, 10, 20, 50, 100, 200, 500, 1000}
+
+type metrics_histogram_t struct {
+	name     string
+	buckets  [11]atomic.Int64 /* len(metrics_histogram_bounds_ms) + 1 */
+	count    atomic.Int64
+	total_us atomic.Int64
+}
+
+func (h *metrics_histogram_t) observe(d time.Duration) {
+	var ms = d.Milliseconds()
+
+	var i = 0
+	for i < len(metrics_histogram_bounds_ms) && ms > metrics_histogram_bounds_ms[i] {
+		i++
+	}
+
+	h.buckets[i].Add(1)
+	h.count.Add(1)
+	h.total_us.Add(d.Microseconds())
+}
+
+/*
+ * The registry.  Everything is registered once, near startup or in
+ * package variable initialisers, so the locking here is never on a
+ * hot path.
+ */
+
+var metrics_mutex sync.Mutex
+var metrics_counters = make(map[string]*metrics_counter_t)
+var metrics_gauges = make(map[string]func() int64)
+var metrics_histograms = make(map[string]*metrics_histogram_t)
+
+/*------------------------------------------------------------------
+ *
+ * Name:        metrics_counter / metrics_gauge / metrics_histogram
+ *
+ * Purpose:     Register (or fetch) an instrument by name.
+ *
+ * Inputs:	name	- Identifies the instrument in the dump.
+ *
+ *		read	- (gauge only) Called when the metrics are
+ *			  read.  Must be safe to call from any thread.
+ *
+ *----------------------------------------------------------------*/
+
+func metrics_counter(name string) *metrics_counter_t {
+	metrics_mutex.Lock()
+	defer metrics_mutex.Unlock()
+
+	var c, ok = metrics_counters[name]
+	if !ok {
+		c = new(metrics_counter_t)
+		c.name = name
+		metrics_counters[name] = c
+	}
+
+	return c
+}
+
+func metrics_gauge(name string, read func() int64) {
+	metrics_mutex.Lock()
+	defer metrics_mutex.Unlock()
+
+	metrics_gauges[name] = read
+}
+
+func metrics_histogram(name string) *metrics_histogram_t {
+	metrics_mutex.Lock()
+	defer metrics_mutex.Unlock()
+
+	var h, ok = metrics_histograms[name]
+	if !ok {
+		h = new(metrics_histogram_t)
+		h.name = name
+		metrics_histograms[name] = h
+	}
+
+	return h
+}
+
+/*------------------------------------------------------------------
+ *
+ * Name:        metrics_text
+ *
+ * Purpose:     Render every registered instrument as "name value"
+ *		lines, sorted by name so the output is stable.
+ *
+ *----------------------------------------------------------------*/
+
+func metrics_text() string {
+	metrics_mutex.Lock()
+	defer metrics_mutex.Unlock()
+
+	var lines []string
+
+	for name, c := range metrics_counters {
+		lines = append(lines, fmt.Sprintf("%s %d", name, c.val.Load()))
+	}
+
+	for name, read := range metrics_gauges {
+		lines = append(lines, fmt.Sprintf("%s %d", name, read()))
+	}
+
+	for name, h := range metrics_histograms {
+		for i, bound := range metrics_histogram_bounds_ms {
+			lines = append(lines, fmt.Sprintf("%s_le_%dms %d", name, bound, h.buckets[i].Load()))
+		}
+
+		lines = append(lines, fmt.Sprintf("%s_over_%dms %d",
+			name, metrics_histogram_bounds_ms[len(metrics_histogram_bounds_ms)-1],
+			h.buckets[len(metrics_histogram_bounds_ms)].Load()))
+		lines = append(lines, fmt.Sprintf("%s_count %d", name, h.count.Load()))
+		lines = append(lines, fmt.Sprintf("%s_total_us %d", name, h.total_us.Load()))
+	}
+
+	sort.Strings(lines)
+
+	return strings.Join(lines, "\n") + "\n"
+} /* end metrics_text */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        metrics_http_init
+ *
+ * Purpose:     Optionally serve the metrics dump over HTTP.
+ *
+ * Inputs:	port	- TCP port, or 0 to disable.
+ *
+ *----------------------------------------------------------------*/
+
+func metrics_http_init(port int) {
+	if port == 0 {
+		return
+	}
+
+	var mux = http.NewServeMux()
+	mux.HandleFunc("/metrics", func(w http.ResponseWriter, _ *http.Request) {
+		fmt.Fprint(w, metrics_text())
+	})
+
+	text_color_set(DW_COLOR_INFO)
+	dw_printf("Ready to accept metrics HTTP requests on port %d.\n", port)
+
+	go func() {
+		var server = new(http.Server)
+		server.Addr = fmt.Sprintf(":%d", port)
+		server.Handler = mux
+		server.ReadHeaderTimeout = 10 * time.Second
+
+		var listenErr = server.ListenAndServe()
+		if listenErr != nil {
+			text_color_set(DW_COLOR_ERROR)
+			dw_printf("Metrics HTTP server failed: %s\n", listenErr)
+		}
+	}()
+} /* end metrics_http_init */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        metrics_periodic_start
+ *
+ * Purpose:     Optionally print the metrics dump to the console at a
+ *		fixed interval.
+ *
+ * Inputs:	interval - Seconds between dumps, or 0 to disable.
+ *
+ *----------------------------------------------------------------*/
+
+func metrics_periodic_start(interval int) {
+	if interval <= 0 {
+		return
+	}
+
+	go func() {
+		for {
+			time.Sleep(time.Duration(interval) * time.Second)
+
+			text_color_set(DW_COLOR_DEBUG)
+			dw_printf("\nMETRICS:\n%s\n", metrics_text())
+		}
+	}()
+} /* end metrics_periodic_start */
+
+/*------------------------------------------------------------------
+ *
+ * Name:        metrics_register_builtin
+ *
+ * Purpose:     Register gauges over counters that already exist
+ *		elsewhere for other reasons.  Called once at startup
+ *		after the subsystems they read from are initialized.
+ *
+ *----------------------------------------------------------------*/
+
+func metrics_register_builtin() {
+	metrics_gauge("ax25_pool_hits", func() int64 {
+		var hits, _ = ax25_pool_stats()
+		return int64(hits)
+	})
+	metrics_gauge("ax25_pool_total", func() int64 {
+		var _, total = ax25_pool_stats()
+		return int64(total)
+	})
+
+	metrics_gauge("dlq_item_pool_hits", func() int64 {
+		var hits, _ = dlq_item_pool_stats()
+		return int64(hits)
+	})
+	metrics_gauge("dlq_item_pool_total", func() int64 {
+		var _, total = dlq_item_pool_stats()
+		return int64(total)
+	})
+
+	metrics_gauge("cdata_pool_hits", func() int64 {
+		var hits, _ = cdata_pool_stats()
+		return int64(hits)
+	})
+	metrics_gauge("cdata_pool_total", func() int64 {
+		var _, total = cdata_pool_stats()
+		return int64(total)
+	})
+
+	metrics_gauge("fir_cache_hits", func() int64 {
+		var hits, _ = fir_cache_stats()
+		return int64(hits)
+	})
+	metrics_gauge("fir_cache_misses", func() int64 {
+		var _, misses = fir_cache_stats()
+		return int64(misses)
+	})
+
+	metrics_gauge("log_records_dropped", func() int64 {
+		if packetLogger == nil {
+			return 0
+		}
+		return int64(packetLogger.Dropped())
+	})
+} /* end metrics_register_builtin */
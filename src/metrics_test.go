@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestMetricsTextRendersInstruments(t *testing.T) {
+	t.Parallel()
+
+	var c = metrics_counter("test_metrics_counter")
+	c.incr()
+	c.add(2)
+
+	metrics_gauge("test_metrics_gauge", func() int64 { return 42 })
+
+	var h = metrics_histogram("test_metrics_histogram")
+	h.observe(3 * time.Millisecond)
+	h.observe(2 * time.Second)
+
+	var text = metrics_text()
+
+	for _, want := range []string{
+		"test_metrics_counter 3",
+		"test_metrics_gauge 42",
+		"test_metrics_histogram_le_5ms 1",
+		"test_metrics_histogram_over_1000ms 1",
+		"test_metrics_histogram_count 2",
+	} {
+		if !strings.Contains(text, want+"\n") {
+			t.Errorf("metrics_text() missing %q:\n%s", want, text)
+		}
+	}
+}
+
+func TestMetricsCounterIsSingleton(t *testing.T) {
+	t.Parallel()
+
+	var a = metrics_counter("test_metrics_singleton")
+	var b = metrics_counter("test_metrics_singleton")
+	if a != b {
+		t.Error("expected the same counter for the same name")
+	}
+}
@@ -66,12 +66,33 @@ type mheard_t struct {
 // MHeardDB maintains a list of all stations heard over the radio or from an
 // Internet Server.  It is getting updated from two different threads so we
 // need a critical region for adding new nodes.
+//
+// Lookups by callsign (WasRecentlyNearby, GetMSP) are single map accesses.
+// The C original kept a linked list which was walked for every query and
+// grew without bound; here only Count and dump touch every entry, and the
+// expiry below keeps "every entry" from meaning everything accumulated
+// since startup.
 type MHeardDB struct {
-	mu    sync.RWMutex
-	db    map[string]*mheard_t
-	debug int
+	mu         sync.RWMutex
+	db         map[string]*mheard_t
+	debug      int
+	last_prune time.Time
 }
 
+/*
+ * Drop stations not heard, by either radio or Internet Server, for this long.
+ *
+ * This only needs to be comfortably larger than every time window the
+ * entries are queried with:  the 180 minute IGate messaging default, the
+ * 30-60 minute statistics reports, and anything a user would sensibly put
+ * in an i/ filter.  After a busy weekend the database then holds the
+ * stations of the past day, not of the whole uptime.
+ */
+
+const MHEARD_RETENTION = 24 * time.Hour
+
+const MHEARD_PRUNE_INTERVAL = 10 * time.Minute
+
 /*------------------------------------------------------------------
  *
  * Function:	NewMHeardDB
@@ -87,10 +108,49 @@ func NewMHeardDB(debug int) *MHeardDB {
 
 	mdb.db = make(map[string]*mheard_t)
 	mdb.debug = debug
+	mdb.last_prune = time.Now()
 
 	return mdb
 } /* end NewMHeardDB */
 
+/*------------------------------------------------------------------
+ *
+ * Function:	prune
+ *
+ * Purpose:	Discard stations not heard for a long time so the
+ *		database size follows recent activity.
+ *
+ * Description:	Called whenever a station is saved, while holding the
+ *		lock, but does a sweep at most every MHEARD_PRUNE_INTERVAL.
+ *
+ *		An entry with an outstanding "message sender position"
+ *		count is kept:  losing it would produce the "Internal
+ *		error: Can't find ... to set MSP" complaint elsewhere.
+ *		In practice msp implies it was heard very recently anyhow.
+ *
+ *------------------------------------------------------------------*/
+
+func (mdb *MHeardDB) prune(now time.Time) {
+	if now.Sub(mdb.last_prune) < MHEARD_PRUNE_INTERVAL {
+		return
+	}
+
+	mdb.last_prune = now
+
+	var cutoff = now.Add(-MHEARD_RETENTION)
+
+	for callsign, mptr := range mdb.db {
+		if mptr.last_heard_rf.Before(cutoff) && mptr.last_heard_is.Before(cutoff) && mptr.msp == 0 {
+			if mdb.debug > 0 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("mheard prune: %s - not heard for over %d hours\n", callsign, int(MHEARD_RETENTION.Hours()))
+			}
+
+			delete(mdb.db, callsign)
+		}
+	}
+} /* end prune */
+
 /*------------------------------------------------------------------
  *
  * Function:	dump
@@ -265,6 +325,8 @@ func (mdb *MHeardDB) SaveRF(channel int, A *decode_aprs_t, pp *packet_t, alevel
 		}
 	}
 
+	mdb.prune(now)
+
 	mdb.mu.Unlock()
 
 	if mdb.debug >= 2 {
@@ -368,6 +430,8 @@ func (mdb *MHeardDB) SaveIS(ptext string) {
 		mptr.last_heard_is = now
 	}
 
+	mdb.prune(now)
+
 	mdb.mu.Unlock()
 
 	// Is is desirable to save any location in this case?
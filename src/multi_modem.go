@@ -67,6 +67,8 @@ import (
 	"math"
 	"math/rand"
 	"os"
+	"runtime"
+	"sync"
 )
 
 // Properties of the radio channels.
@@ -98,6 +100,121 @@ const PROCESS_AFTER_BITS = 3
 
 var process_age [MAX_RADIO_CHANS]int
 
+/*
+ * Optional parallel decoding.
+ *
+ * With something like "MODEM 1200 D3" we can easily have 9 demodulators,
+ * each with multiple slicers, per channel.  Originally every one of them
+ * was fed each audio sample, serially, on the audio input thread.  That
+ * pins a single core while the others sit idle on a multi-core system.
+ *
+ * When a channel has more than one demodulator, and more than one CPU is
+ * available, we hand each demodulator (subchannel) its own worker goroutine.
+ * Samples are accumulated into blocks so we pay the channel send and
+ * scheduling cost once per block rather than once per sample.  All workers
+ * process the same block, we wait for them to finish, and then perform the
+ * candidate aging / pick_best_candidate bookkeeping exactly as before.
+ *
+ * The barrier after each block means all the existing state - candidates,
+ * HDLC decoders, FX.25 block reception - is only ever touched for sample n+1
+ * after everyone is done with sample n, same as the serial case.  Each worker
+ * writes only its own demodulator_state / hdlc_state / candidate cells.
+ */
+
+const MM_BLOCK_SIZE = 64 // Samples per block.  Small compared to process_age
+// (3 bit times, e.g. 120 samples at 48k/1200bd) so
+// candidate picking is not delayed noticeably.
+
+var mm_parallel [MAX_RADIO_CHANS]bool
+var mm_block [MAX_RADIO_CHANS][]int
+var mm_work [MAX_RADIO_CHANS][MAX_SUBCHANS]chan []int
+var mm_wg [MAX_RADIO_CHANS]sync.WaitGroup
+
+func multi_modem_start_workers(channel int) {
+	mm_block[channel] = make([]int, 0, MM_BLOCK_SIZE)
+
+	for d := 0; d < save_audio_config_p.achan[channel].num_subchan; d++ {
+		var work = make(chan []int, 1)
+		mm_work[channel][d] = work
+
+		var subchan = d // capture for goroutine
+
+		go func() {
+			for block := range work {
+				demod_process_block(channel, subchan, block)
+
+				mm_wg[channel].Done()
+			}
+		}()
+	}
+
+	mm_parallel[channel] = true
+}
+
+func multi_modem_stop_workers() {
+	for channel := range MAX_RADIO_CHANS {
+		if mm_parallel[channel] {
+			multi_modem_flush(channel)
+
+			for d := range mm_work[channel] {
+				if mm_work[channel][d] != nil {
+					close(mm_work[channel][d])
+					mm_work[channel][d] = nil
+				}
+			}
+
+			mm_parallel[channel] = false
+		}
+	}
+}
+
+/* Push any partial block through the workers and settle candidates. */
+/* Called at each full block, and should be called at end of input */
+/* (e.g. end of WAV file in atest) so trailing frames are not lost. */
+
+func multi_modem_flush(channel int) {
+	if !mm_parallel[channel] || len(mm_block[channel]) == 0 {
+		return
+	}
+
+	var block = mm_block[channel]
+	var num_subchan = save_audio_config_p.achan[channel].num_subchan
+
+	mm_wg[channel].Add(num_subchan)
+
+	for d := 0; d < num_subchan; d++ {
+		mm_work[channel][d] <- block
+	}
+
+	mm_wg[channel].Wait()
+
+	mm_block[channel] = block[:0]
+
+	mm_age_candidates(channel, len(block))
+}
+
+/* Same bookkeeping as the serial per-sample loop but advanced a whole */
+/* block at a time.  A candidate stored partway through a block gets */
+/* credited with the whole block, so allow an extra block of slack */
+/* before picking - a pick can be slightly late but never early. */
+
+func mm_age_candidates(channel int, elapsed int) {
+	for subchan := 0; subchan < save_audio_config_p.achan[channel].num_subchan; subchan++ {
+		for slice := 0; slice < save_audio_config_p.achan[channel].num_slicers; slice++ {
+			if candidate[channel][subchan][slice].packet_p != nil {
+				candidate[channel][subchan][slice].age += elapsed
+				if candidate[channel][subchan][slice].age > process_age[channel]+MM_BLOCK_SIZE {
+					if fx25_rec_busy(channel) {
+						candidate[channel][subchan][slice].age = 0
+					} else {
+						pick_best_candidate(channel)
+					}
+				}
+			}
+		}
+	}
+}
+
 /*------------------------------------------------------------------------------
  *
  * Name:	multi_modem_init
@@ -114,6 +231,11 @@ var process_age [MAX_RADIO_CHANS]int
  *------------------------------------------------------------------------------*/
 
 func multi_modem_init(pa *audio_s) {
+	/* atest calls this once per input file.  Make sure workers from a */
+	/* previous configuration are gone before state is reinitialized. */
+
+	multi_modem_stop_workers()
+
 	/*
 	 * Save audio configuration for later use.
 	 */
@@ -139,8 +261,25 @@ func multi_modem_init(pa *audio_s) {
 				real_baud = save_audio_config_p.achan[channel].baud / 3
 			}
 
-			process_age[channel] = PROCESS_AFTER_BITS * save_audio_config_p.adev[ACHAN2ADEV(channel)].samples_per_sec / real_baud
+			/* Candidate age is counted in samples as seen by the */
+			/* demodulators, which is the decimated rate when the */
+			/* shared channel decimator is active. */
+
+			var samples_per_sec = save_audio_config_p.adev[ACHAN2ADEV(channel)].samples_per_sec
+			if channel_decimator[channel] != nil {
+				samples_per_sec /= save_audio_config_p.achan[channel].decimate
+			}
+
+			process_age[channel] = PROCESS_AFTER_BITS * samples_per_sec / real_baud
 			//crc_queue_of_last_to_app[channel] = nil;
+
+			/* Parallel decoding pays off only with multiple demodulators */
+			/* and multiple cores.  A single subchannel with multiple */
+			/* slicers is still one demodulator so nothing to fan out. */
+
+			if save_audio_config_p.achan[channel].num_subchan > 1 && runtime.NumCPU() > 1 {
+				multi_modem_start_workers(channel)
+			}
 		}
 	}
 }
@@ -204,6 +343,32 @@ func multi_modem_process_sample(channel int, audio_sample int) {
 		os.Exit(1)
 	}
 
+	/* Sample rate reduction (the -D option) is done once here, ahead */
+	/* of the demodulators, rather than by every subchannel.  Most */
+	/* input samples don't produce a decimated output so we're done. */
+
+	if channel_decimator[channel] != nil {
+		var out, ready = decimator_sample(channel_decimator[channel], audio_sample)
+		if !ready {
+			return
+		}
+
+		audio_sample = out
+	}
+
+	/* Parallel mode: batch samples into a block and fan out to the */
+	/* per-subchannel workers.  Candidate aging is done per block, */
+	/* after the barrier, in multi_modem_flush. */
+
+	if mm_parallel[channel] {
+		mm_block[channel] = append(mm_block[channel], audio_sample)
+		if len(mm_block[channel]) >= MM_BLOCK_SIZE {
+			multi_modem_flush(channel)
+		}
+
+		return
+	}
+
 	/* Formerly one loop. */
 	/* 1.2: We can feed one demodulator but end up with multiple outputs. */
 
@@ -21,6 +21,7 @@ import (
 	"fmt"
 	"strconv"
 	"strings"
+	"sync"
 	"unicode"
 )
 
@@ -54,6 +55,59 @@ func pfilter_init(p_igate_config *igate_config_s, debug_level int) {
 	save_igate_config_p = p_igate_config
 }
 
+/*
+ * Compiled filter programs.
+ *
+ * The filter strings come from the configuration file and never change
+ * while running, but pfilter used to re-tokenize and re-parse the whole
+ * expression for every packet on every from-chan/to-chan pair.  With a
+ * handful of multi-clause IGate and digipeater filters, the parser was
+ * the most expensive non-DSP item at busy-frequency packet rates.
+ *
+ * Instead, the first use of each filter string compiles it into a tree
+ * of closures: callsign lists become hash sets with a separate list of
+ * wildcard prefixes, and things like the r/lat/lon/dist arguments are
+ * converted from text once.  Subsequent packets pay only for evaluation.
+ *
+ * A failed compile is cached too (as a nil program) so a bad filter
+ * reports its error once instead of once per packet, while pfilter
+ * still returns -1 each time.
+ */
+
+type pfcompiled_t func(pf *pfstate_t) int
+
+type pfcache_key_t struct {
+	filter  string
+	is_aprs bool
+}
+
+var pfilter_cache = make(map[pfcache_key_t]pfcompiled_t)
+var pfilter_cache_mutex sync.Mutex
+
+func pfilter_get_compiled(from_chan int, to_chan int, filter string, is_aprs bool) pfcompiled_t {
+	var key = pfcache_key_t{filter: filter, is_aprs: is_aprs}
+
+	pfilter_cache_mutex.Lock()
+	var prog, found = pfilter_cache[key]
+	pfilter_cache_mutex.Unlock()
+
+	if found {
+		return prog
+	}
+
+	// Not holding the lock while compiling means two threads could both
+	// compile the same new filter.  That is harmless - they produce
+	// equivalent programs - and it keeps evaluation out of the lock.
+
+	prog = pfilter_compile(from_chan, to_chan, filter, is_aprs)
+
+	pfilter_cache_mutex.Lock()
+	pfilter_cache[key] = prog
+	pfilter_cache_mutex.Unlock()
+
+	return prog
+}
+
 type token_type_t int
 
 const (
@@ -164,47 +218,32 @@ func pfilter(from_chan int, to_chan int, filter string, pp *packet_t, is_aprs bo
 		return (-1)
 	}
 
-	var pfstate pfstate_t
-
-	pfstate.from_chan = from_chan
-	pfstate.to_chan = to_chan
+	var prog = pfilter_get_compiled(from_chan, to_chan, filter, is_aprs)
 
-	/* Copy filter string, changing any control characters to spaces. */
-
-	pfstate.filter_str = filter
-	pfstate.filter_str = strings.Map(func(r rune) rune {
-		if unicode.IsControl(r) {
-			return ' '
-		} else {
-			return r
-		}
-	}, pfstate.filter_str)
-
-	pfstate.toBeParsed = pfstate.filter_str
-
-	pfstate.pp = pp
-	pfstate.is_aprs = is_aprs
+	var result int
+	if prog == nil {
+		/* Filter string did not compile.  Error was reported then. */
+		result = -1
+	} else {
+		var pfstate pfstate_t
 
-	if is_aprs {
-		pfstate.decoded = decode_aprs(pp, true, "")
-	}
+		pfstate.from_chan = from_chan
+		pfstate.to_chan = to_chan
 
-	next_token(&pfstate)
+		/* Keep a cleaned copy for error message context. */
 
-	var result int
-	if pfstate.token_type == TOKEN_EOL {
-		/* Empty filter means reject all. */
-		result = 0
-	} else {
-		result = parse_expr(&pfstate)
+		pfstate.filter_str = pfilter_clean(filter)
 
-		if pfstate.token_type != TOKEN_AND &&
-			pfstate.token_type != TOKEN_OR &&
-			pfstate.token_type != TOKEN_EOL {
-			print_error(&pfstate, "Expected logical operator or end of line here.")
+		pfstate.pp = pp
+		pfstate.is_aprs = is_aprs
 
-			result = -1
+		if is_aprs {
+			// Cheap decode is enough here - the filters look only at
+			// packet type, addresses, position, and symbol.
+			pfstate.decoded = decode_aprs_cheap(pp, true, "")
 		}
+
+		result = prog(&pfstate)
 	}
 
 	if pfilter_debug >= 1 {
@@ -224,6 +263,73 @@ func pfilter(from_chan int, to_chan int, filter string, pp *packet_t, is_aprs bo
 	return (result)
 } /* end pfilter */
 
+/* Copy of filter string, changing any control characters to spaces. */
+
+func pfilter_clean(filter string) string {
+	return strings.Map(func(r rune) rune {
+		if unicode.IsControl(r) {
+			return ' '
+		} else {
+			return r
+		}
+	}, filter)
+}
+
+/*-------------------------------------------------------------------
+ *
+ * Name:   	pfilter_compile
+ *
+ * Purpose:     Turn a filter string into a reusable predicate program.
+ *
+ * Inputs:	from_chan, to_chan	- For error messages only.
+ *
+ *		filter	- String of filter specs and logical operators.
+ *
+ *		is_aprs	- True for APRS, false for connected mode digipeater.
+ *
+ * Returns:	Evaluation function, or nil if the filter has an error
+ *		which would make it return -1 for every packet.
+ *
+ * Description:	Errors whose visibility depends on the packet being
+ *		processed (e.g. a bad pattern in a d/ list is only hit
+ *		when the packet actually has a used digipeater) are left
+ *		in the program so evaluation still returns the same
+ *		results as the old parse-per-packet implementation.
+ *
+ *--------------------------------------------------------------------*/
+
+func pfilter_compile(from_chan int, to_chan int, filter string, is_aprs bool) pfcompiled_t {
+	var pfstate pfstate_t
+
+	pfstate.from_chan = from_chan
+	pfstate.to_chan = to_chan
+	pfstate.filter_str = pfilter_clean(filter)
+	pfstate.toBeParsed = pfstate.filter_str
+	pfstate.is_aprs = is_aprs
+
+	next_token(&pfstate)
+
+	if pfstate.token_type == TOKEN_EOL {
+		/* Empty filter means reject all. */
+		return func(pf *pfstate_t) int { return 0 }
+	}
+
+	var prog = compile_expr(&pfstate)
+	if prog == nil {
+		return nil
+	}
+
+	if pfstate.token_type != TOKEN_AND &&
+		pfstate.token_type != TOKEN_OR &&
+		pfstate.token_type != TOKEN_EOL {
+		print_error(&pfstate, "Expected logical operator or end of line here.")
+
+		return nil
+	}
+
+	return prog
+} /* end pfilter_compile */
+
 /*-------------------------------------------------------------------
  *
  * Name:   	next_token
@@ -317,134 +423,175 @@ func next_token(pf *pfstate_t) {
 
 /*-------------------------------------------------------------------
  *
- * Name:   	parse_expr
- *		parse_or_expr
- *		parse_and_expr
- *		parse_primary
+ * Name:   	compile_expr
+ *		compile_or_expr
+ *		compile_and_expr
+ *		compile_primary
  *
- * Purpose:     Recursive descent parser to evaluate filter specifications
+ * Purpose:     Recursive descent parser to compile filter specifications
  *		contained within expressions with & | ! ( ).
  *
  * Inputs:	pf	- Pointer to current state information.
  *
- * Returns:	 1 = yes
+ * Returns:	Evaluation function, or nil for a syntax error.
+ *
+ *		The evaluation functions themselves return:
+ *
+ *		 1 = yes
  *		 0 = no
  *		-1 = error detected
  *
  *--------------------------------------------------------------------*/
 
-func parse_expr(pf *pfstate_t) int {
-	return parse_or_expr(pf)
+func compile_expr(pf *pfstate_t) pfcompiled_t {
+	return compile_or_expr(pf)
 }
 
 /* or_expr::	and_expr [ | and_expr ] ... */
 
-func parse_or_expr(pf *pfstate_t) int {
-	var result = parse_and_expr(pf)
-	if result < 0 {
-		return (-1)
+func compile_or_expr(pf *pfstate_t) pfcompiled_t {
+	var result = compile_and_expr(pf)
+	if result == nil {
+		return nil
 	}
 
 	for pf.token_type == TOKEN_OR {
 		next_token(pf)
-		var e = parse_and_expr(pf)
-
-		if pfilter_debug >= 3 {
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("  %s | %s\n", bool2text(result), bool2text(e))
+		var e = compile_and_expr(pf)
+		if e == nil {
+			return nil
 		}
 
-		if e < 0 {
-			return (-1)
-		}
+		var left, right = result, e
+		result = func(pf *pfstate_t) int {
+			var a = left(pf)
+			if a < 0 {
+				return (-1)
+			}
 
-		result |= e
+			var b = right(pf)
+
+			if pfilter_debug >= 3 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("  %s | %s\n", bool2text(a), bool2text(b))
+			}
+
+			if b < 0 {
+				return (-1)
+			}
+
+			return a | b
+		}
 	}
 
-	return (result)
+	return result
 }
 
 /* and_expr::	primary [ & primary ] ... */
 
-func parse_and_expr(pf *pfstate_t) int {
-	var result = parse_primary(pf)
-	if result < 0 {
-		return (-1)
+func compile_and_expr(pf *pfstate_t) pfcompiled_t {
+	var result = compile_primary(pf)
+	if result == nil {
+		return nil
 	}
 
 	for pf.token_type == TOKEN_AND {
 		next_token(pf)
-		var e = parse_primary(pf)
-
-		if pfilter_debug >= 3 {
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("  %s & %s\n", bool2text(result), bool2text(e))
+		var e = compile_primary(pf)
+		if e == nil {
+			return nil
 		}
 
-		if e < 0 {
-			return (-1)
-		}
+		var left, right = result, e
+		result = func(pf *pfstate_t) int {
+			var a = left(pf)
+			if a < 0 {
+				return (-1)
+			}
+
+			var b = right(pf)
+
+			if pfilter_debug >= 3 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("  %s & %s\n", bool2text(a), bool2text(b))
+			}
 
-		result &= e
+			if b < 0 {
+				return (-1)
+			}
+
+			return a & b
+		}
 	}
 
-	return (result)
+	return result
 }
 
 /* primary::	( expr )	*/
 /* 		! primary	*/
 /*		filter_spec	*/
 
-func parse_primary(pf *pfstate_t) int {
-	var result int
-
-	if pf.token_type == TOKEN_LPAREN { //nolint:staticcheck
+func compile_primary(pf *pfstate_t) pfcompiled_t {
+	if pf.token_type == TOKEN_LPAREN {
 		next_token(pf)
-		result = parse_expr(pf)
+		var result = compile_expr(pf)
+		if result == nil {
+			return nil
+		}
 
-		if pf.token_type == TOKEN_RPAREN {
-			next_token(pf)
-		} else {
+		if pf.token_type != TOKEN_RPAREN {
 			print_error(pf, "Expected \")\" here.\n")
 
-			result = -1
+			return nil
 		}
-	} else if pf.token_type == TOKEN_NOT {
+
 		next_token(pf)
-		var e = parse_primary(pf)
 
-		if pfilter_debug >= 3 {
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("  ! %s\n", bool2text(e))
+		return result
+	}
+
+	if pf.token_type == TOKEN_NOT {
+		next_token(pf)
+		var e = compile_primary(pf)
+		if e == nil {
+			return nil
 		}
 
-		if e < 0 {
-			result = -1
-		} else {
-			result = 1 - e
+		return func(pf *pfstate_t) int {
+			var v = e(pf)
+
+			if pfilter_debug >= 3 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("  ! %s\n", bool2text(v))
+			}
+
+			if v < 0 {
+				return (-1)
+			}
+
+			return 1 - v
 		}
-	} else if pf.token_type == TOKEN_FILTER_SPEC {
-		result = parse_filter_spec(pf)
-	} else {
-		print_error(pf, "Expected filter specification, (, or ! here.")
+	}
 
-		result = -1
+	if pf.token_type == TOKEN_FILTER_SPEC {
+		return compile_filter_spec(pf)
 	}
 
-	return (result)
+	print_error(pf, "Expected filter specification, (, or ! here.")
+
+	return nil
 }
 
 /*-------------------------------------------------------------------
  *
- * Name:   	parse_filter_spec
+ * Name:   	compile_filter_spec
  *
- * Purpose:     Parse and evaluate filter specification.
+ * Purpose:     Compile a filter specification into an evaluation function.
  *
  * Inputs:	pf	- Pointer to current state information.
  *
- * Returns:	 1 = yes
- *		 0 = no
- *		-1 = error detected
+ * Returns:	Evaluation function, or nil for an error which would
+ *		make every evaluation return -1.
  *
  * Description:	All filter specifications are allowed for APRS.
  *		Only those dealing with addresses are allowed for connected digipeater.
@@ -456,205 +603,221 @@ func parse_primary(pf *pfstate_t) int {
  *
  *--------------------------------------------------------------------*/
 
-func parse_filter_spec(pf *pfstate_t) int {
-	// Yes this is always assigned over, but that requires a fair bit of reading to be sure of, so let's have an explicit default
-	var result = -1 //nolint:ineffassign,wastedassign
+func compile_filter_spec(pf *pfstate_t) pfcompiled_t {
+	var spec = pf.token_str
+	var tokeni = pf.tokeni
 
-	if (!pf.is_aprs) && !strings.ContainsRune("01bdvu", rune(pf.token_str[0])) {
+	if (!pf.is_aprs) && !strings.ContainsRune("01bdvu", rune(spec[0])) {
 		print_error(pf, "Only b, d, v, and u specifications are allowed for connected mode digipeater filtering.")
 
-		result = -1
-
 		next_token(pf)
 
-		return (result)
+		return nil
 	}
 
+	var prog pfcompiled_t
+
 	/* undocumented: can use 0 or 1 for testing. */
 
-	if pf.token_str == "0" {
-		result = 0
-	} else if pf.token_str == "1" {
-		result = 1
-	} else if pf.token_str[0] == 'b' && unicode.IsPunct(rune(pf.token_str[1])) {
+	if spec == "0" {
+		prog = func(pf *pfstate_t) int { return 0 }
+	} else if spec == "1" {
+		prog = func(pf *pfstate_t) int { return 1 }
+	} else if spec[0] == 'b' && unicode.IsPunct(rune(spec[1])) {
 		/* simple string matching */
 
 		/* b - budlist */
 		/* Budlist - AX.25 source address */
 		/* Could be different than source encapsulated by 3rd party header. */
-		var addr = ax25_get_addr_with_ssid(pf.pp, AX25_SOURCE)
-		result = filt_bodgu(pf, addr)
+		var matcher = compile_budlist(pf)
 
-		if pfilter_debug >= 2 {
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), addr)
+		prog = func(pf *pfstate_t) int {
+			var addr = ax25_get_addr_with_ssid(pf.pp, AX25_SOURCE)
+			var result = matcher.matches(addr)
+
+			if pfilter_debug >= 2 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("   %s returns %s for %s\n", spec, bool2text(result), addr)
+			}
+
+			return result
 		}
-	} else if pf.token_str[0] == 'o' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 'o' && unicode.IsPunct(rune(spec[1])) {
 		/* o - object or item name */
-		result = filt_bodgu(pf, pf.decoded.g_name)
+		var matcher = compile_budlist(pf)
 
-		if pfilter_debug >= 2 {
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), pf.decoded.g_name)
+		prog = func(pf *pfstate_t) int {
+			var result = matcher.matches(pf.decoded.g_name)
+
+			if pfilter_debug >= 2 {
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("   %s returns %s for %s\n", spec, bool2text(result), pf.decoded.g_name)
+			}
+
+			return result
 		}
-	} else if pf.token_str[0] == 'd' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 'd' && unicode.IsPunct(rune(spec[1])) {
 		/* d - was digipeated by */
-		// Loop on all AX.25 digipeaters.
-		result = 0
-		for n := AX25_REPEATER_1; result == 0 && n < ax25_get_num_addr(pf.pp); n++ {
-			// Consider only those with the H (has-been-used) bit set.
-			if ax25_get_h(pf.pp, n) > 0 {
-				var addr = ax25_get_addr_with_ssid(pf.pp, n)
-				result = filt_bodgu(pf, addr)
+		var matcher = compile_budlist(pf)
+
+		prog = func(pf *pfstate_t) int {
+			// Loop on all AX.25 digipeaters.
+			var result = 0
+			for n := AX25_REPEATER_1; result == 0 && n < ax25_get_num_addr(pf.pp); n++ {
+				// Consider only those with the H (has-been-used) bit set.
+				if ax25_get_h(pf.pp, n) > 0 {
+					var addr = ax25_get_addr_with_ssid(pf.pp, n)
+					result = matcher.matches(addr)
+				}
 			}
-		}
 
-		if pfilter_debug >= 2 {
-			var path = ax25_format_via_path(pf.pp)
+			if pfilter_debug >= 2 {
+				var path = ax25_format_via_path(pf.pp)
 
-			if len(path) == 0 {
-				path = "no digipeater path"
+				if len(path) == 0 {
+					path = "no digipeater path"
+				}
+
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("   %s returns %s for %s\n", spec, bool2text(result), path)
 			}
 
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), path)
+			return result
 		}
-	} else if pf.token_str[0] == 'v' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 'v' && unicode.IsPunct(rune(spec[1])) {
 		/* v - via not used */
-		// loop on all AX.25 digipeaters (mnemonic Via)
-		result = 0
-		for n := AX25_REPEATER_1; result == 0 && n < ax25_get_num_addr(pf.pp); n++ {
-			// This is different than the previous "d" filter.
-			// Consider only those where the the H (has-been-used) bit is NOT set.
-			if ax25_get_h(pf.pp, n) == 0 {
-				var addr = ax25_get_addr_with_ssid(pf.pp, n)
-				result = filt_bodgu(pf, addr)
+		var matcher = compile_budlist(pf)
+
+		prog = func(pf *pfstate_t) int {
+			// loop on all AX.25 digipeaters (mnemonic Via)
+			var result = 0
+			for n := AX25_REPEATER_1; result == 0 && n < ax25_get_num_addr(pf.pp); n++ {
+				// This is different than the previous "d" filter.
+				// Consider only those where the the H (has-been-used) bit is NOT set.
+				if ax25_get_h(pf.pp, n) == 0 {
+					var addr = ax25_get_addr_with_ssid(pf.pp, n)
+					result = matcher.matches(addr)
+				}
 			}
-		}
 
-		if pfilter_debug >= 2 {
-			var path = ax25_format_via_path(pf.pp)
+			if pfilter_debug >= 2 {
+				var path = ax25_format_via_path(pf.pp)
 
-			if len(path) == 0 {
-				path = "no digipeater path"
+				if len(path) == 0 {
+					path = "no digipeater path"
+				}
+
+				text_color_set(DW_COLOR_DEBUG)
+				dw_printf("   %s returns %s for %s\n", spec, bool2text(result), path)
 			}
 
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), path)
+			return result
 		}
-	} else if pf.token_str[0] == 'g' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 'g' && unicode.IsPunct(rune(spec[1])) {
 		/* g - Addressee of message. e.g. "BLN*" for bulletins. */
-		if pf.decoded.g_message_subtype == message_subtype_message ||
-			pf.decoded.g_message_subtype == message_subtype_ack ||
-			pf.decoded.g_message_subtype == message_subtype_rej ||
-			pf.decoded.g_message_subtype == message_subtype_bulletin ||
-			pf.decoded.g_message_subtype == message_subtype_nws ||
-			pf.decoded.g_message_subtype == message_subtype_directed_query {
-			result = filt_bodgu(pf, pf.decoded.g_addressee)
+		var matcher = compile_budlist(pf)
+
+		prog = func(pf *pfstate_t) int {
+			if pf.decoded.g_message_subtype == message_subtype_message ||
+				pf.decoded.g_message_subtype == message_subtype_ack ||
+				pf.decoded.g_message_subtype == message_subtype_rej ||
+				pf.decoded.g_message_subtype == message_subtype_bulletin ||
+				pf.decoded.g_message_subtype == message_subtype_nws ||
+				pf.decoded.g_message_subtype == message_subtype_directed_query {
+				var result = matcher.matches(pf.decoded.g_addressee)
+
+				if pfilter_debug >= 2 {
+					text_color_set(DW_COLOR_DEBUG)
+					dw_printf("   %s returns %s for %s\n", spec, bool2text(result), pf.decoded.g_addressee)
+				}
 
-			if pfilter_debug >= 2 {
-				text_color_set(DW_COLOR_DEBUG)
-				dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), pf.decoded.g_addressee)
+				return result
 			}
-		} else {
-			result = 0
 
 			if pfilter_debug >= 2 {
 				text_color_set(DW_COLOR_DEBUG)
-				dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), "not a message")
+				dw_printf("   %s returns %s for %s\n", spec, bool2text(0), "not a message")
 			}
+
+			return 0
 		}
-	} else if pf.token_str[0] == 'u' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 'u' && unicode.IsPunct(rune(spec[1])) {
 		/* u - unproto (AX.25 destination) */
-		/* Probably want to exclude mic-e types */
-		/* because destination is used for part of location. */
-		if ax25_get_dti(pf.pp) != '\'' && ax25_get_dti(pf.pp) != '`' {
-			var addr = ax25_get_addr_with_ssid(pf.pp, AX25_DESTINATION)
-			result = filt_bodgu(pf, addr)
+		var matcher = compile_budlist(pf)
+
+		prog = func(pf *pfstate_t) int {
+			/* Probably want to exclude mic-e types */
+			/* because destination is used for part of location. */
+			if ax25_get_dti(pf.pp) != '\'' && ax25_get_dti(pf.pp) != '`' {
+				var addr = ax25_get_addr_with_ssid(pf.pp, AX25_DESTINATION)
+				var result = matcher.matches(addr)
+
+				if pfilter_debug >= 2 {
+					text_color_set(DW_COLOR_DEBUG)
+					dw_printf("   %s returns %s for %s\n", spec, bool2text(result), addr)
+				}
 
-			if pfilter_debug >= 2 {
-				text_color_set(DW_COLOR_DEBUG)
-				dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), addr)
+				return result
 			}
-		} else {
-			result = 0
 
 			if pfilter_debug >= 2 {
 				text_color_set(DW_COLOR_DEBUG)
-				dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), "MIC-E packet type")
+				dw_printf("   %s returns %s for %s\n", spec, bool2text(0), "MIC-E packet type")
 			}
+
+			return 0
 		}
-	} else if pf.token_str[0] == 't' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 't' && unicode.IsPunct(rune(spec[1])) {
 		/* t - packet type: position, weather, telemetry, etc. */
-		result = filt_t(pf)
+		// Whether an invalid letter is reached depends on the packet
+		// (earlier letters can match first), so this is not validated
+		// at compile time.
+		prog = func(pf *pfstate_t) int {
+			pf.token_str = spec
+			pf.tokeni = tokeni
+			var result = filt_t(pf)
 
-		if pfilter_debug >= 2 {
-			var infop = AX25GetInfo(pf.pp)
+			if pfilter_debug >= 2 {
+				var infop = AX25GetInfo(pf.pp)
 
-			if len(infop) > 0 {
-				text_color_set(DW_COLOR_DEBUG)
-				dw_printf("   %s returns %s for %c data type indicator\n", pf.token_str, bool2text(result), infop[0])
-			} else {
-				text_color_set(DW_COLOR_DEBUG)
-				dw_printf("   %s returns %s for empty info part\n", pf.token_str, bool2text(result))
+				if len(infop) > 0 {
+					text_color_set(DW_COLOR_DEBUG)
+					dw_printf("   %s returns %s for %c data type indicator\n", spec, bool2text(result), infop[0])
+				} else {
+					text_color_set(DW_COLOR_DEBUG)
+					dw_printf("   %s returns %s for empty info part\n", spec, bool2text(result))
+				}
 			}
-		}
-	} else if pf.token_str[0] == 'r' && unicode.IsPunct(rune(pf.token_str[1])) {
-		/* r - range */
-		/* range */
-		var sdist string
-		result, sdist = filt_r(pf)
 
-		if pfilter_debug >= 2 {
-			text_color_set(DW_COLOR_DEBUG)
-			dw_printf("   %s returns %s for %s\n", pf.token_str, bool2text(result), sdist)
+			return result
 		}
-	} else if pf.token_str[0] == 's' && unicode.IsPunct(rune(pf.token_str[1])) {
+	} else if spec[0] == 'r' && unicode.IsPunct(rune(spec[1])) {
+		/* r - range */
+		prog = compile_filt_r(pf)
+	} else if spec[0] == 's' && unicode.IsPunct(rune(spec[1])) {
 		/* s - symbol */
-		result = filt_s(pf)
-
-		if pfilter_debug >= 2 {
-			text_color_set(DW_COLOR_DEBUG)
-
-			if pf.decoded.g_symbol_table == '/' { //nolint:staticcheck
-				dw_printf("   %s returns %s for symbol %c in primary table\n", pf.token_str, bool2text(result), pf.decoded.g_symbol_code)
-			} else if pf.decoded.g_symbol_table == '\\' {
-				dw_printf("   %s returns %s for symbol %c in alternate table\n", pf.token_str, bool2text(result), pf.decoded.g_symbol_code)
-			} else {
-				dw_printf("   %s returns %s for symbol %c with overlay %c\n", pf.token_str, bool2text(result), pf.decoded.g_symbol_code, pf.decoded.g_symbol_table)
-			}
-		}
-	} else if pf.token_str[0] == 'i' && unicode.IsPunct(rune(pf.token_str[1])) {
+		prog = compile_filt_s(pf)
+	} else if spec[0] == 'i' && unicode.IsPunct(rune(spec[1])) {
 		/* i - IGate messaging default */
 		/* IGatge messaging */
-		result = filt_i(pf)
-
-		if pfilter_debug >= 2 {
-			text_color_set(DW_COLOR_DEBUG)
-
-			if pf.decoded.g_packet_type == packet_type_message {
-				dw_printf("   %s returns %s for message to %s\n", pf.token_str, bool2text(result), pf.decoded.g_addressee)
-			} else {
-				dw_printf("   %s returns %s for not an APRS 'message'\n", pf.token_str, bool2text(result))
-			}
-		}
+		prog = compile_filt_i(pf)
 	} else {
 		/* unrecognized filter type */
-		print_error(pf, fmt.Sprintf("Unrecognized filter type '%c'", pf.token_str[0]))
+		print_error(pf, fmt.Sprintf("Unrecognized filter type '%c'", spec[0]))
 
-		result = -1
+		prog = nil
 	}
 
 	next_token(pf)
 
-	return (result)
+	return prog
 }
 
 /*------------------------------------------------------------------------------
  *
- * Name:	filt_bodgu
+ * Name:	compile_budlist
  *
- * Purpose:	Filter with text pattern matching
+ * Purpose:	Compile a text pattern matching filter.
  *
  * Inputs:	pf	- Pointer to current state information.
  *			  token_str should have one of these filter specs:
@@ -666,25 +829,38 @@ func parse_filter_spec(pf *pfstate_t) int {
  * 				Unproto		u/unproto1/unproto2...
  *				Via-not-yet	v/digi1/digi2...noteapd
  *
- *		arg	- Value to match from source addr, destination,
- *			  used digipeater, object name, etc.
- *
- * Returns:	 1 = yes
- *		 0 = no
- *		-1 = error detected
+ * Returns:	Matcher which can be applied to source addr, destination,
+ *		used digipeater, object name, etc.
  *
- * Description:	Same function is used for all of these because they are so similar.
+ * Description:	Same matcher is used for all of these because they are so similar.
  *		Look for exact match to any of the specified strings.
  *		All of them allow wildcarding with single * at the end.
  *
+ *		Exact patterns go in a hash set and wildcards in a short
+ *		prefix list, so matching does not re-split the spec for
+ *		every packet.
+ *
+ *		A misplaced wildcard is not a compile-time failure because
+ *		the old code only reported it when the matcher was actually
+ *		applied, which for d/ and v/ depends on the packet having
+ *		a digipeater to test.  The matcher reports it instead.
+ *
  *------------------------------------------------------------------------------*/
 
-func filt_bodgu(pf *pfstate_t, arg string) int {
-	var result = 0
+type pfbudlist_t struct {
+	exact    map[string]struct{} /* Patterns without wildcard. */
+	prefixes []string            /* Patterns with * removed from the end. */
+	bad      bool                /* Misplaced wildcard.  Error result for any argument. */
+}
+
+func compile_budlist(pf *pfstate_t) *pfbudlist_t {
 	var str = pf.token_str
 	var sep = str[1]
 	var cp = str[2:]
 
+	var b = new(pfbudlist_t)
+	b.exact = make(map[string]struct{})
+
 	var parts = strings.Split(cp, string(sep))
 	for _, part := range parts {
 		var idx = strings.Index(part, "*")
@@ -692,21 +868,36 @@ func filt_bodgu(pf *pfstate_t, arg string) int {
 			/* Wildcarding.  Should have single * on end. */
 			if idx != (len(part) - 1) {
 				print_error(pf, "Any wildcard * must be at the end of pattern.\n")
-				return (-1)
-			}
+				b.bad = true
 
-			if strings.HasPrefix(arg, part[:idx]) {
-				result = 1
+				return b
 			}
+
+			b.prefixes = append(b.prefixes, part[:idx])
 		} else {
-			/* Try for exact match. */
-			if part == arg {
-				result = 1
-			}
+			b.exact[part] = struct{}{}
 		}
 	}
 
-	return (result)
+	return b
+}
+
+func (b *pfbudlist_t) matches(arg string) int {
+	if b.bad {
+		return (-1)
+	}
+
+	if _, ok := b.exact[arg]; ok {
+		return (1)
+	}
+
+	for _, prefix := range b.prefixes {
+		if strings.HasPrefix(arg, prefix) {
+			return (1)
+		}
+	}
+
+	return (0)
 }
 
 /*------------------------------------------------------------------------------
@@ -821,88 +1012,100 @@ func filt_t(pf *pfstate_t) int {
 
 /*------------------------------------------------------------------------------
  *
- * Name:	filt_r
+ * Name:	compile_filt_r
  *
- * Purpose:	Is it in range (kilometers) of given location.
+ * Purpose:	Compile test for being in range (kilometers) of given location.
  *
  * Inputs:	pf	- Pointer to current state information.
  *			  token_str should contain something of format:
  *
  *				r/lat/lon/dist
  *
- *			  We also need to know the location (if any) from the packet.
+ *			  Evaluation also needs the location (if any) from the packet.
  *
  *				decoded.g_lat & decoded.g_lon
  *
- * Returns:	 1 = yes
- *		 0 = no
- *		-1 = error detected
+ * Returns:	Evaluation function.
  *
- *      sdist	- Distance as a string for troubleshooting.
+ * Description:	The reference point and distance are converted from text
+ *		here, once, rather than for every packet.
  *
- *
- * Description:
+ *		A malformed spec is reported here but still produces an
+ *		evaluation function:  like the old code, it returns -1
+ *		only for packets which have a location, 0 otherwise.
  *
  *------------------------------------------------------------------------------*/
 
-func filt_r(pf *pfstate_t) (int, string) {
-	if pf.decoded.g_lat == G_UNKNOWN || pf.decoded.g_lon == G_UNKNOWN {
-		return 0, ""
-	}
+func compile_filt_r(pf *pfstate_t) pfcompiled_t {
+	var spec = pf.token_str
+	var sep = string(spec[1])
+	var cp = spec[2:]
 
-	var str = pf.token_str
-	var sep = string(str[1])
-	var cp = str[2:]
+	var bad = false
+	var dlat, dlon, ddist float64
 
 	var parts = strings.Split(cp, sep)
 
 	if len(parts) < 1 {
 		print_error(pf, "Missing latitude for Range filter.")
-		return -1, ""
-	}
-	var dlat, _ = strconv.ParseFloat(parts[0], 64)
-
-	if len(parts) < 2 {
+		bad = true
+	} else if len(parts) < 2 {
 		print_error(pf, "Missing longitude for Range filter.")
-		return -1, ""
-	}
-	var dlon, _ = strconv.ParseFloat(parts[1], 64)
-
-	if len(parts) < 3 {
+		bad = true
+	} else if len(parts) < 3 {
 		print_error(pf, "Missing distance for Range filter.")
-		return -1, ""
-	}
-	var ddist, _ = strconv.ParseFloat(parts[2], 64)
-
-	if len(parts) > 3 {
+		bad = true
+	} else if len(parts) > 3 {
 		print_error(pf, "Too many parts for Range filter.")
-		return -1, ""
+		bad = true
+	} else {
+		dlat, _ = strconv.ParseFloat(parts[0], 64)
+		dlon, _ = strconv.ParseFloat(parts[1], 64)
+		ddist, _ = strconv.ParseFloat(parts[2], 64)
 	}
 
-	var km = ll_distance_km(dlat, dlon, float64(pf.decoded.g_lat), float64(pf.decoded.g_lon))
-	var sdist = fmt.Sprintf("%.2f km", km)
+	return func(pf *pfstate_t) int {
+		var result int
+		var sdist string
 
-	if km <= ddist {
-		return 1, sdist
-	}
+		if pf.decoded.g_lat == G_UNKNOWN || pf.decoded.g_lon == G_UNKNOWN {
+			result = 0
+		} else if bad {
+			result = -1
+		} else {
+			var km = ll_distance_km(dlat, dlon, float64(pf.decoded.g_lat), float64(pf.decoded.g_lon))
+			sdist = fmt.Sprintf("%.2f km", km)
+
+			if km <= ddist {
+				result = 1
+			} else {
+				result = 0
+			}
+		}
 
-	return 0, sdist
+		if pfilter_debug >= 2 {
+			text_color_set(DW_COLOR_DEBUG)
+			dw_printf("   %s returns %s for %s\n", spec, bool2text(result), sdist)
+		}
+
+		return result
+	}
 }
 
 /*------------------------------------------------------------------------------
  *
- * Name:	filt_s
+ * Name:	compile_filt_s
  *
- * Purpose:	Filter by symbol.
+ * Purpose:	Compile filter by symbol.
  *
  * Inputs:	pf	- Pointer to current state information.
  *			  token_str should contain something of format:
  *
  *				s/pri/alt/over
  *
- * Returns:	 1 = yes
- *		 0 = no
- *		-1 = error detected
+ * Returns:	Evaluation function, or nil for a syntax error.
+ *		The strict syntax check does not depend on the packet so
+ *		it happens entirely at compile time.
  *
  * Description:
  *
@@ -954,10 +1157,10 @@ func filt_r(pf *pfstate_t) (int, string) {
  *
  *------------------------------------------------------------------------------*/
 
-func filt_s(pf *pfstate_t) int {
-	var str = pf.token_str
-	var sep = string(str[1])
-	var cp = str[2:]
+func compile_filt_s(pf *pfstate_t) pfcompiled_t {
+	var spec = pf.token_str
+	var sep = string(spec[1])
+	var cp = spec[2:]
 	var pri, alt, over string
 
 	var unacceptableChar = func(r rune) bool {
@@ -975,7 +1178,7 @@ func filt_s(pf *pfstate_t) int {
 
 		if strings.ContainsFunc(pri, unacceptableChar) {
 			print_error(pf, "Symbol filter, primary must be printable ASCII character(s) other than | or ~.")
-			return (-1)
+			return nil
 		}
 
 		if len(parts) > 1 {
@@ -985,12 +1188,12 @@ func filt_s(pf *pfstate_t) int {
 
 			if len(alt) == 0 {
 				print_error(pf, "Nothing specified for alternate symbol table.")
-				return (-1)
+				return nil
 			}
 
 			if strings.ContainsFunc(alt, unacceptableChar) {
 				print_error(pf, "Symbol filter, alternate must be printable ASCII character(s) other than | or ~.")
-				return (-1)
+				return nil
 			}
 
 			if len(parts) > 2 {
@@ -1002,26 +1205,48 @@ func filt_s(pf *pfstate_t) int {
 					return !(unicode.IsUpper(r) || unicode.IsDigit(r) || r == '\\')
 				}) {
 					print_error(pf, "Symbol filter, overlay must be upper case letter, digit, or \\.")
-					return (-1)
+					return nil
 				}
 
 				if len(parts) > 3 {
 					print_error(pf, "More than 3 delimiter characters in Symbol filter.")
-					return (-1)
+					return nil
 				}
 			}
 		} else {
 			// No alt part is OK if at least one primary symbol was specified.
 			if len(pri) == 0 {
 				print_error(pf, "No symbols specified for Symbol filter.")
-				return (-1)
+				return nil
 			}
 		}
 	} else {
 		print_error(pf, "Missing arguments for Symbol filter.")
-		return (-1)
+		return nil
+	}
+
+	var have_over_part = len(parts) > 2
+
+	return func(pf *pfstate_t) int {
+		var result = filt_s_eval(pf, pri, alt, over, have_over_part)
+
+		if pfilter_debug >= 2 {
+			text_color_set(DW_COLOR_DEBUG)
+
+			if pf.decoded.g_symbol_table == '/' { //nolint:staticcheck
+				dw_printf("   %s returns %s for symbol %c in primary table\n", spec, bool2text(result), pf.decoded.g_symbol_code)
+			} else if pf.decoded.g_symbol_table == '\\' {
+				dw_printf("   %s returns %s for symbol %c in alternate table\n", spec, bool2text(result), pf.decoded.g_symbol_code)
+			} else {
+				dw_printf("   %s returns %s for symbol %c with overlay %c\n", spec, bool2text(result), pf.decoded.g_symbol_code, pf.decoded.g_symbol_table)
+			}
+		}
+
+		return result
 	}
+} /* end compile_filt_s */
 
+func filt_s_eval(pf *pfstate_t, pri string, alt string, over string, have_over_part bool) int {
 	// This applies only for Position, Object, Item.
 	// decode_aprs() should set symbol code to space to mean undefined.
 
@@ -1052,7 +1277,7 @@ func filt_s(pf *pfstate_t) int {
 	if strings.Contains(alt, string(rune(pf.decoded.g_symbol_code))) {
 		// We have a match but that might not be enough.
 		// We must see if there was an overlay part specified.
-		if len(parts) > 2 {
+		if have_over_part {
 			if len(over) > 0 {
 				// Non-zero length overlay part was specified.
 				// Need to match one of them.
@@ -1081,13 +1306,13 @@ func filt_s(pf *pfstate_t) int {
 	}
 
 	return (0)
-} /* end filt_s */
+} /* end filt_s_eval */
 
 /*------------------------------------------------------------------------------
  *
- * Name:	filt_i
+ * Name:	compile_filt_i
  *
- * Purpose:	IGate messaging filter.
+ * Purpose:	Compile IGate messaging filter.
  *		This would make sense only for IS>RF direction.
  *
  * Inputs:	pf	- Pointer to current state information.
@@ -1095,9 +1320,8 @@ func filt_s(pf *pfstate_t) int {
  *
  *				i/time/hops/lat/lon/km
  *
- * Returns:	 1 = yes
- *		 0 = no
- *		-1 = error detected
+ * Returns:	Evaluation function, or nil for a syntax error.
+ *		The parameters are converted from text once, here.
  *
  * Description: Selection is based on time since last heard on RF, and distance
  *		in terms of digipeater hops and/or physical location.
@@ -1174,7 +1398,7 @@ func filt_s(pf *pfstate_t) int {
  *
  *------------------------------------------------------------------------------*/
 
-func filt_i(pf *pfstate_t) int {
+func compile_filt_i(pf *pfstate_t) pfcompiled_t {
 	// http://lists.tapr.org/pipermail/aprssig_lists.tapr.org/2020-July/048656.html
 	// Default of 3 hours should be good.
 	// One might question why to have a time limit at all.  Messages are very rare
@@ -1189,15 +1413,9 @@ func filt_i(pf *pfstate_t) int {
 	var dlon float64 = G_UNKNOWN
 	var km float64 = G_UNKNOWN
 
-	//char src[AX25_MAX_ADDR_LEN];
-	//char *infop = nil;
-	//int info_len;
-	//char *f;
-	//char addressee[AX25_MAX_ADDR_LEN];
-
-	var str = pf.token_str
-	var sep = string(str[1])
-	var cp = str[2:]
+	var spec = pf.token_str
+	var sep = string(spec[1])
+	var cp = spec[2:]
 
 	var parts = strings.Split(cp, sep)
 
@@ -1207,7 +1425,7 @@ func filt_i(pf *pfstate_t) int {
 		heardtime, _ = strconv.Atoi(parts[0])
 	} else {
 		print_error(pf, "Missing time limit for IGate message filter.")
-		return (-1)
+		return nil
 	}
 
 	if len(parts) > 1 {
@@ -1215,7 +1433,7 @@ func filt_i(pf *pfstate_t) int {
 			maxhops, _ = strconv.Atoi(parts[1])
 		} else {
 			print_error(pf, "Missing max digipeater hops for IGate message filter.")
-			return (-1)
+			return nil
 		}
 
 		if len(parts) > 2 && len(parts[2]) > 0 {
@@ -1225,23 +1443,41 @@ func filt_i(pf *pfstate_t) int {
 				dlon, _ = strconv.ParseFloat(parts[3], 64)
 			} else {
 				print_error(pf, "Missing longitude for IGate message filter.")
-				return (-1)
+				return nil
 			}
 
 			if len(parts) > 4 && len(parts[4]) > 0 {
 				km, _ = strconv.ParseFloat(parts[4], 64)
 			} else {
 				print_error(pf, "Missing distance, in km, for IGate message filter.")
-				return (-1)
+				return nil
 			}
 		}
 
 		if len(parts) > 5 {
 			print_error(pf, "Something unexpected after distance for IGate message filter.")
-			return (-1)
+			return nil
+		}
+	}
+
+	return func(pf *pfstate_t) int {
+		var result = filt_i_eval(pf, heardtime, maxhops, dlat, dlon, km)
+
+		if pfilter_debug >= 2 {
+			text_color_set(DW_COLOR_DEBUG)
+
+			if pf.decoded.g_packet_type == packet_type_message {
+				dw_printf("   %s returns %s for message to %s\n", spec, bool2text(result), pf.decoded.g_addressee)
+			} else {
+				dw_printf("   %s returns %s for not an APRS 'message'\n", spec, bool2text(result))
+			}
 		}
+
+		return result
 	}
+} /* end compile_filt_i */
 
+func filt_i_eval(pf *pfstate_t, heardtime int, maxhops int, dlat float64, dlon float64, km float64) int {
 	/*
 	 * Get source address and info part.
 	 * Addressee has already been extracted into pf.decoded.g_addressee.
@@ -1305,7 +1541,7 @@ func filt_i(pf *pfstate_t) int {
 	return (1)
 
 	// #endif
-} /* end filt_i */
+} /* end filt_i_eval */
 
 /*-------------------------------------------------------------------
  *
@@ -12,6 +12,12 @@ package direwolf
  *
  * Version 1.3:	Store as bytes rather than packing 8 bits per byte.
  *
+ * Samoyed:	Back to packed storage, one bit per bit, in uint64 words.
+ *		The FIX_BITS retry search in hdlc_rec2 re-reads the whole
+ *		buffer for every trial bit inversion, so we want the
+ *		buffer compact in cache and we want trial inversions to
+ *		be a single XOR (rrbb_flip_bit) rather than a copy.
+ *
  *******************************************************************************/
 
 var new_count = 0
@@ -25,6 +31,10 @@ var delete_count = 0
 
 const MAX_NUM_BITS = (MAX_FRAME_LEN * 8 * 6 / 5)
 
+/* Number of uint64 words needed to hold MAX_NUM_BITS. */
+
+const RRBB_NUM_WORDS = (MAX_NUM_BITS + 63) / 64
+
 type rrbb_t struct {
 	magic1 int
 	nextp  *rrbb_t /* Next pointer to maintain a queue. */
@@ -41,7 +51,7 @@ type rrbb_t struct {
 	descram_state int  /* Descrambler state before first data bit of frame. */
 	prev_descram  int  /* Previous descrambled bit. */
 
-	fdata [MAX_NUM_BITS]byte
+	data [RRBB_NUM_WORDS]uint64 /* Bits, packed LSB first within each word. */
 
 	magic2 int
 }
@@ -147,7 +157,14 @@ func rrbb_append_bit(b *rrbb_t, val byte) {
 		return /* Silently discard if full. */
 	}
 
-	b.fdata[b.length] = val
+	/* The buffer is reused without clearing so we must both set and clear. */
+
+	if val != 0 {
+		b.data[b.length>>6] |= uint64(1) << (uint(b.length) & 63)
+	} else {
+		b.data[b.length>>6] &^= uint64(1) << (uint(b.length) & 63)
+	}
+
 	b.length++
 }
 
@@ -203,7 +220,7 @@ func rrbb_get_len(b *rrbb_t) int {
  ***********************************************************************************/
 
 func rrbb_get_bit(b *rrbb_t, ind int) byte {
-	return b.fdata[ind]
+	return byte((b.data[ind>>6] >> (uint(ind) & 63)) & 1)
 }
 
 /***********************************************************************************
@@ -215,23 +232,132 @@ func rrbb_get_bit(b *rrbb_t, ind int) byte {
  * Inputs:	Handle for bit array.
  *		Index into array.
  *
+ * Description:	XOR is its own inverse so flipping the same position again
+ *		restores the original value.  The retry logic in hdlc_rec2
+ *		relies on this to try a bit inversion in place and then
+ *		back it out, without ever copying the buffer.
+ *
+ ***********************************************************************************/
+
+func rrbb_flip_bit(b *rrbb_t, ind int) {
+	b.data[ind>>6] ^= uint64(1) << (uint(ind) & 63)
+}
+
+/***********************************************************************************
+ *
+ * Name:	rrbb_compute_dbits
+ *
+ * Purpose:	Undo the G3RUH scrambling (if any) and the NRZI encoding
+ *		for the whole buffer at once, 64 bits per step.
+ *
+ * Inputs:	b	- Handle for bit array.
+ *
+ * Outputs:	dbits	- Data bits, packed the same way as b.data.
+ *			  Bit i is the decoded value of raw bit i.
+ *			  Bit 0 is meaningless; callers start at bit 1
+ *			  because bit 0 is the last bit of the opening flag.
+ *			  Must have at least RRBB_NUM_WORDS elements.
+ *
+ * Description:	The descrambler in hdlc_rec.go is just a shift register
+ *		of past raw input bits, so descrambled bit i only depends
+ *		on raw bits at fixed offsets:
+ *
+ *			descram[i] = raw[i] ^ raw[i-12] ^ raw[i-17]
+ *
+ *		and NRZI decoding compares adjacent descrambled bits:
+ *
+ *			dbit[i] = NOT (descram[i] ^ descram[i-1])
+ *
+ *		Both are plain XORs of shifted copies of the bit stream,
+ *		so we can produce 64 data bits with a handful of word
+ *		operations instead of two function calls per bit.  The
+ *		raw bits from before the buffer started come from the
+ *		saved descrambler state, exactly as the bit-at-a-time
+ *		code would read them out of its shift register.
+ *
+ *		This matters because the FIX_BITS retry search re-decodes
+ *		the entire buffer for every trial bit inversion.
+ *
  ***********************************************************************************/
 
-//void rrbb_flip_bit (*rrbb_t b, unsigned int ind)
-//{
-//	unsigned int di, mi;
-//
-//	Assert (b != nil);
-//	Assert (b.magic1 == MAGIC1);
-//	Assert (b.magic2 == MAGIC2);
-//
-//	Assert (ind < b.len);
-//
-//	di = ind / SOI;
-//	mi = ind % SOI;
-//
-//	b.data[di] ^= masks[mi];
-//}
+func rrbb_compute_dbits(b *rrbb_t, dbits []uint64) {
+	Assert(b != nil)
+	Assert(b.magic1 == MAGIC1)
+	Assert(b.magic2 == MAGIC2)
+
+	var nwords = (b.length + 63) / 64
+	if nwords == 0 {
+		return
+	}
+
+	if !b.is_scrambled {
+		/* dbit[i] = NOT (raw[i] ^ raw[i-1]).  Raw bit -1 never matters */
+		/* because bit 0 of the result is not used. */
+
+		var carry uint64 = 0
+		for k := range nwords {
+			var w = b.data[k]
+			dbits[k] = ^(w ^ ((w << 1) | carry))
+			carry = w >> 63
+		}
+
+		return
+	}
+
+	/*
+	 * Scrambled.  Build an extended copy of the raw bit stream with the
+	 * 18 bits of history from the saved shift register in front, so the
+	 * taps can reach back before the start of the buffer.  Extended bit
+	 * (i + 17) is raw bit i; extended bits 0 .. 17 are state bits
+	 * 17 .. 0, i.e. the raw bits received just before bit 1.
+	 *
+	 * Note that extended bit 17 comes from the state, not from the
+	 * buffer.  They started out identical, but a trial inversion of
+	 * bit 0 changes only the buffer, and the bit-at-a-time code reads
+	 * its history from the untouched shift register.
+	 */
+
+	var ext [RRBB_NUM_WORDS + 1]uint64
+
+	var lead uint64 = 0
+	for p := 0; p <= 17; p++ {
+		lead |= uint64((b.descram_state>>(17-p))&1) << p
+	}
+
+	ext[0] = ((b.data[0] >> 1) << 18) | lead
+	for k := 1; k <= nwords && k <= RRBB_NUM_WORDS; k++ {
+		var hi uint64 = 0
+		if k < RRBB_NUM_WORDS {
+			hi = b.data[k]
+		}
+		ext[k] = (hi << 17) | (b.data[k-1] >> 47)
+	}
+
+	/* 64 extended bits starting at the given bit offset. */
+
+	var get64 = func(off int) uint64 {
+		var v = ext[off>>6] >> (uint(off) & 63)
+		if uint(off)&63 != 0 {
+			v |= ext[(off>>6)+1] << (64 - uint(off)&63)
+		}
+		return v
+	}
+
+	var carry uint64 = 0
+	for k := range nwords {
+		/* raw[i] ^ raw[i-12] ^ raw[i-17] for i = 64k .. 64k+63. */
+
+		var d = get64(64*k+17) ^ get64(64*k+5) ^ get64(64*k)
+
+		if k == 0 {
+			/* Descrambled bit 0 is given, not computed. */
+			d = (d &^ 1) | uint64(b.prev_descram&1)
+		}
+
+		dbits[k] = ^(d ^ ((d << 1) | carry))
+		carry = d >> 63
+	}
+} /* end rrbb_compute_dbits */
 
 /***********************************************************************************
  *
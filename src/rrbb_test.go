@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: The Samoyed Authors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+package direwolf
+
+import (
+	"testing"
+)
+
+// The word-parallel rrbb_compute_dbits must agree, bit for bit, with
+// feeding the buffer through the bit-at-a-time descrambler and NRZI
+// decoder the way try_decode used to.
+
+func TestRrbbComputeDbitsMatchesPerBit(t *testing.T) {
+	var rng = new(bench_rand_t)
+	rng.state = bench_seed
+
+	for _, scrambled := range []bool{false, true} {
+		for _, blen := range []int{2, 17, 63, 64, 65, 128, 300, 1000} {
+			for trial := range 10 {
+				var state = int(rng.next()) & 0x3ffff
+				var prev = int(rng.next()) & 1
+
+				var b = rrbb_new(0, 0, 0, scrambled, state, prev)
+
+				for range blen {
+					rrbb_append_bit(b, byte(rng.next()&1))
+				}
+
+				var dbits [RRBB_NUM_WORDS]uint64
+				rrbb_compute_dbits(b, dbits[:])
+
+				// Bit-at-a-time reference, as try_decode used to do it.
+
+				var lfsr = state
+				var prev_descram = prev
+				var prev_raw = rrbb_get_bit(b, 0) > 0
+
+				for i := 1; i < blen; i++ {
+					var raw = rrbb_get_bit(b, i) > 0
+
+					var want bool
+					if scrambled {
+						var descram = descramble(IfThenElse(raw, 1, 0), &lfsr)
+						want = descram == prev_descram
+						prev_descram = descram
+					} else {
+						want = raw == prev_raw
+					}
+					prev_raw = raw
+
+					var got = (dbits[i>>6]>>(uint(i)&63))&1 != 0
+					if got != want {
+						t.Fatalf("scrambled=%t blen=%d trial=%d: bit %d is %t, want %t",
+							scrambled, blen, trial, i, got, want)
+					}
+				}
+
+				rrbb_delete(b)
+			}
+		}
+	}
+}
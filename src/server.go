@@ -126,6 +126,13 @@ var client_sock [MAX_NET_CLIENTS]net.Conn
 /* Socket for */
 /* communication with client application. */
 
+var client_queue [MAX_NET_CLIENTS]*clientQueue //nolint:gochecknoglobals
+
+/* Bounded outbound queue, drained by its own writer goroutine, */
+/* so one stalled client can't block the fan-out path for everyone */
+/* else.  See client_queue.go.  Set before client_sock on accept */
+/* and cleared by its onDead cleanup. */
+
 var enable_send_raw_to_client [MAX_NET_CLIENTS]bool
 
 /* Should we send received packets to client app in raw form? */
@@ -411,6 +418,16 @@ func server_connect_listen_thread(server_port int) {
 				continue
 			}
 
+			client_queue[client] = newClientQueue(conn, func(reason string) {
+				if reason != "" {
+					text_color_set(DW_COLOR_ERROR)
+					dw_printf("\n%s\nClosing connection to AGW client application %d.\n\n", reason, client)
+				}
+
+				client_queue[client] = nil
+				client_sock[client] = nil
+				dlq_client_cleanup(client)
+			})
 			client_sock[client] = conn
 
 			text_color_set(DW_COLOR_INFO)
@@ -454,42 +471,50 @@ func server_connect_listen_thread(server_port int) {
 func server_send_rec_packet(channel int, pp *packet_t, fbuf []byte) {
 	/*
 	 * RAW format
+	 *
+	 * The message is identical for every interested client, so build and
+	 * marshal it once, on first need, then give each client a single
+	 * socket write of the shared bytes.
 	 */
+	var agwpe_msg *AGWPEMessage
+	var raw_msg []byte
+
 	for client := range MAX_NET_CLIENTS {
-		if enable_send_raw_to_client[client] && client_sock[client] != nil {
-			var agwpe_msg = new(AGWPEMessage)
+		var q = client_queue[client]
 
-			agwpe_msg.Header.Portx = byte(channel)
+		if enable_send_raw_to_client[client] && q != nil {
+			if agwpe_msg == nil {
+				agwpe_msg = new(AGWPEMessage)
 
-			agwpe_msg.Header.DataKind = 'K'
+				agwpe_msg.Header.Portx = byte(channel)
 
-			var callFrom = ax25_get_addr_with_ssid(pp, AX25_SOURCE)
-			copy(agwpe_msg.Header.CallFrom[:], []byte(callFrom))
+				agwpe_msg.Header.DataKind = 'K'
 
-			var callTo = ax25_get_addr_with_ssid(pp, AX25_DESTINATION)
-			copy(agwpe_msg.Header.CallTo[:], []byte(callTo))
+				var callFrom = ax25_get_addr_with_ssid(pp, AX25_SOURCE)
+				copy(agwpe_msg.Header.CallFrom[:], []byte(callFrom))
+
+				var callTo = ax25_get_addr_with_ssid(pp, AX25_DESTINATION)
+				copy(agwpe_msg.Header.CallTo[:], []byte(callTo))
+
+				agwpe_msg.Header.DataLen = uint32(len(fbuf) + 1)
+				agwpe_msg.Data = make([]byte, len(fbuf)+1)
 
-			agwpe_msg.Header.DataLen = uint32(len(fbuf) + 1)
-			agwpe_msg.Data = make([]byte, len(fbuf)+1)
+				/* Stick in extra byte for the "TNC" to use. */
 
-			/* Stick in extra byte for the "TNC" to use. */
+				agwpe_msg.Data[0] = byte(channel) << 4 // Was 0.  Fixed in 1.8.
 
-			agwpe_msg.Data[0] = byte(channel) << 4 // Was 0.  Fixed in 1.8.
+				copy(agwpe_msg.Data[1:], fbuf)
 
-			copy(agwpe_msg.Data[1:], fbuf)
+				raw_msg = agwpe_msg.Bytes(binary.LittleEndian)
+			}
 
 			if debug_client > 0 {
 				debug_print(TO_CLIENT, client, agwpe_msg)
 			}
 
-			var _, err = agwpe_msg.Write(client_sock[client], binary.LittleEndian)
-			if err != nil {
-				text_color_set(DW_COLOR_ERROR)
-				dw_printf("\nError sending message to AGW client application.  Closing connection.\n\n")
-				client_sock[client].Close()
-				client_sock[client] = nil
-				dlq_client_cleanup(client)
-			}
+			// Non-blocking: a stalled client drops messages and is
+			// eventually evicted rather than holding up this loop.
+			q.Send(raw_msg)
 		}
 	}
 
@@ -507,7 +532,9 @@ func server_send_monitored(channel int, pp *packet_t, own_xmit int) {
 	 *			'T' for own transmitted frames.
 	 */
 	for client := range MAX_NET_CLIENTS {
-		if enable_send_monitor_to_client[client] && client_sock[client] != nil {
+		var q = client_queue[client]
+
+		if enable_send_monitor_to_client[client] && q != nil {
 			var agwpe_msg = new(AGWPEMessage)
 
 			agwpe_msg.Header.Portx = byte(channel) // datakind is added later.
@@ -585,14 +612,7 @@ func server_send_monitored(channel int, pp *packet_t, own_xmit int) {
 				debug_print(TO_CLIENT, client, agwpe_msg)
 			}
 
-			var _, err = agwpe_msg.Write(client_sock[client], binary.LittleEndian)
-			if err != nil {
-				text_color_set(DW_COLOR_ERROR)
-				dw_printf("\nError sending message to AGW client application %d (%s).  Closing connection.\n\n", client, err)
-				client_sock[client].Close()
-				client_sock[client] = nil
-				dlq_client_cleanup(client)
-			}
+			q.Send(agwpe_msg.Bytes(binary.LittleEndian))
 		}
 	}
 } /* server_send_monitored */
@@ -914,7 +934,8 @@ func server_outstanding_frames_reply(channel int, client int, own_call string, r
  *--------------------------------------------------------------------*/
 
 func send_to_client(client int, reply_p *AGWPEMessage) {
-	if client_sock[client] == nil {
+	var q = client_queue[client]
+	if q == nil {
 		return
 	}
 
@@ -930,7 +951,7 @@ func send_to_client(client int, reply_p *AGWPEMessage) {
 		debug_print(TO_CLIENT, client, reply_p)
 	}
 
-	reply_p.Write(client_sock[client], binary.LittleEndian)
+	q.Send(reply_p.Bytes(binary.LittleEndian))
 }
 
 func cmd_listen_thread(client int) {
@@ -948,9 +969,11 @@ func cmd_listen_thread(client int) {
 			text_color_set(DW_COLOR_ERROR)
 			dw_printf("\nError getting message header from AGW client application %d: %s\n", client, readErr)
 			dw_printf("Closing connection.\n\n")
-			client_sock[client].Close()
-			client_sock[client] = nil
-			dlq_client_cleanup(client)
+
+			var q = client_queue[client]
+			if q != nil {
+				q.Evict("") // Also closes socket and does cleanup.
+			}
 
 			continue
 		}
@@ -982,9 +1005,11 @@ func cmd_listen_thread(client int) {
 				dw_printf("\nError getting message data from AGW client application %d: %s\n", client, readErr)
 				dw_printf("Tried to read %d bytes, got %d.\n", cmd.Header.DataLen, n)
 				dw_printf("Closing connection.\n\n")
-				client_sock[client].Close()
-				client_sock[client] = nil
-				dlq_client_cleanup(client)
+
+				var q = client_queue[client]
+				if q != nil {
+					q.Evict("") // Also closes socket and does cleanup.
+				}
 
 				return
 			}
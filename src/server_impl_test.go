@@ -30,16 +30,25 @@ func readReplyFrom(conn net.Conn) (*AGWPEMessage, error) {
 	return msg, nil
 }
 
-// setupClientPipe wires client_sock[0] to one end of an in-memory net.Pipe
-// and returns the other end for reading replies.
+// setupClientPipe wires client_sock[0] (and its outbound queue) to one end
+// of an in-memory net.Pipe and returns the other end for reading replies.
 func setupClientPipe(t *testing.T) net.Conn {
 	t.Helper()
 	var server, client = net.Pipe()
+	client_queue[0] = newClientQueue(server, func(reason string) {
+		client_queue[0] = nil
+		client_sock[0] = nil
+	})
 	client_sock[0] = server
 	t.Cleanup(func() {
+		var q = client_queue[0]
+		if q != nil {
+			q.Evict("")
+		}
 		server.Close()
 		client.Close()
 		client_sock[0] = nil
+		client_queue[0] = nil
 	})
 	return client
 }
@@ -17,6 +17,7 @@ package direwolf
  *---------------------------------------------------------------*/
 
 import (
+	"fmt"
 	"sync"
 	"time"
 
@@ -30,8 +31,16 @@ const TQ_PRIO_1_LO = 1
 
 var queue_head [MAX_RADIO_CHANS][TQ_NUM_PRIO]*packet_t /* Head of linked list for each queue. */
 
-var tq_mutex sync.Mutex /* Critical section for updating queues. */
-/* Just one for all queues. */
+var queue_tail [MAX_RADIO_CHANS][TQ_NUM_PRIO]*packet_t /* Tail of same, so append does not */
+/* need to walk the whole list while holding the lock. */
+
+var queue_count [MAX_RADIO_CHANS][TQ_NUM_PRIO]int /* Number of real packets in each queue */
+var queue_bytes [MAX_RADIO_CHANS][TQ_NUM_PRIO]int /* and their total frame bytes, maintained */
+/* at append/remove so the common tq_count queries are constant time. */
+
+var tq_mutex [MAX_RADIO_CHANS]sync.Mutex /* Critical section for updating queues. */
+/* One per channel so a busy connected-mode transfer on one channel */
+/* does not contend with traffic for the others. */
 
 var wake_up_cond [MAX_RADIO_CHANS]*sync.Cond /* Notify transmit thread when queue not empty. */
 
@@ -87,6 +96,9 @@ func tq_init(audio_config_p *audio_s) {
 	for c := range MAX_RADIO_CHANS {
 		for p := range TQ_NUM_PRIO {
 			queue_head[c][p] = nil
+			queue_tail[c][p] = nil
+			queue_count[c][p] = 0
+			queue_bytes[c][p] = 0
 		}
 	}
 
@@ -100,6 +112,10 @@ func tq_init(audio_config_p *audio_s) {
 
 		if audio_config_p.chan_medium[c] == MEDIUM_RADIO {
 			wake_up_cond[c] = sync.NewCond(&wake_up_mutex[c])
+
+			metrics_gauge(fmt.Sprintf("tq_depth_chan%d", c), func() int64 {
+				return int64(tq_count(c, -1, "", "", false))
+			})
 		}
 	}
 } /* end tq_init */
@@ -266,42 +282,50 @@ func tq_append(channel int, prio int, pp *packet_t) {
 	#endif
 	*/
 
-	tq_mutex.Lock()
+	tq_append_internal(channel, prio, pp)
+} /* end tq_append */
+
+/*-------------------------------------------------------------------
+ *
+ * Name:        tq_append_internal
+ *
+ * Purpose:     Common part of tq_append, lm_data_request and
+ *		lm_seize_request, after their individual validation.
+ *
+ * Description:	Add packet to the queue tail and update the packet/byte
+ *		counters - all constant time, so the lock is held only
+ *		briefly no matter how long the queue has grown.
+ *		Signal the transmit thread if it is waiting.
+ *
+ *--------------------------------------------------------------------*/
+
+func tq_append_internal(channel int, prio int, pp *packet_t) {
+	tq_mutex[channel].Lock()
 
 	if queue_head[channel][prio] == nil {
 		queue_head[channel][prio] = pp
 	} else {
-		var pnext *packet_t
+		ax25_set_nextp(queue_tail[channel][prio], pp)
+	}
 
-		var plast = queue_head[channel][prio]
-		for {
-			pnext = ax25_get_nextp(plast)
-			if pnext == nil {
-				break
-			}
+	queue_tail[channel][prio] = pp
 
-			plast = pnext
-		}
+	/* Only real packets are counted, to match the traversal in tq_count. */
+	/* The empty frames from lm_seize_request are not. */
 
-		ax25_set_nextp(plast, pp)
+	if ax25_get_num_addr(pp) >= AX25_MIN_ADDRS {
+		queue_count[channel][prio]++
+		queue_bytes[channel][prio] += ax25_get_frame_len(pp)
 	}
 
-	tq_mutex.Unlock()
-
-	/* TODO KG
-	#if DEBUG
-		text_color_set(DW_COLOR_DEBUG);
-		dw_printf ("tq_append: left critical section\n");
-		dw_printf ("tq_append (): about to wake up xmit thread.\n");
-	#endif
-	*/
+	tq_mutex[channel].Unlock()
 
 	if xmit_thread_is_waiting[channel] {
 		wake_up_mutex[channel].Lock()
 		wake_up_cond[channel].Signal()
 		wake_up_mutex[channel].Unlock()
 	}
-} /* end tq_append */
+} /* end tq_append_internal */
 
 /*-------------------------------------------------------------------
  *
@@ -438,53 +462,15 @@ func lm_data_request(channel int, prio int, pp *packet_t) {
 	#endif
 	*/
 
-	tq_mutex.Lock()
-
-	if queue_head[channel][prio] == nil {
-		queue_head[channel][prio] = pp
-	} else {
-		var plast = queue_head[channel][prio]
-		for {
-			var pnext = ax25_get_nextp(plast)
-			if pnext == nil {
-				break
-			}
-
-			plast = pnext
-		}
-
-		ax25_set_nextp(plast, pp)
-	}
-
-	tq_mutex.Unlock()
-
-	/* TODO KG
-	#if DEBUG
-		text_color_set(DW_COLOR_DEBUG);
-		dw_printf ("lm_data_request: left critical section\n");
-	#endif
-	*/
-
 	// Appendix C2a, from the Ax.25 protocol spec, says that a priority frame
 	// will start transmission.  If not already transmitting, normal frames
 	// will pile up until LM-SEIZE Request starts transmission.
 
 	// Erratum: It doesn't take long for that to fail.
 	// We send SABM(e) frames to the transmit queue and the transmitter doesn't get activated.
+	// So the transmit thread is awakened for any priority, in tq_append_internal.
 
-	//NO!	if (prio == TQ_PRIO_0_HI) {
-
-	/* TODO KG
-	   #if DEBUG
-	   	  dw_printf ("lm_data_request (): about to wake up xmit thread.\n");
-	   #endif
-	*/
-	if xmit_thread_is_waiting[channel] {
-		wake_up_mutex[channel].Lock()
-		wake_up_cond[channel].Signal()
-		wake_up_mutex[channel].Unlock()
-	}
-	//NO!	}
+	tq_append_internal(channel, prio, pp)
 } /* end lm_data_request */
 
 /*-------------------------------------------------------------------
@@ -585,44 +571,7 @@ func lm_seize_request(channel int) {
 	   #endif
 	*/
 
-	tq_mutex.Lock()
-
-	if queue_head[channel][prio] == nil {
-		queue_head[channel][prio] = pp
-	} else {
-		var plast = queue_head[channel][prio]
-		for {
-			var pnext = ax25_get_nextp(plast)
-			if pnext == nil {
-				break
-			}
-
-			plast = pnext
-		}
-
-		ax25_set_nextp(plast, pp)
-	}
-
-	tq_mutex.Unlock()
-
-	/* TODO KG
-	#if DEBUG
-		text_color_set(DW_COLOR_DEBUG);
-		dw_printf ("lm_seize_request: left critical section\n");
-	#endif
-	*/
-
-	/* TODO KG
-	   #if DEBUG
-	   	dw_printf ("lm_seize_request (): about to wake up xmit thread.\n");
-	   #endif
-	*/
-
-	if xmit_thread_is_waiting[channel] {
-		wake_up_mutex[channel].Lock()
-		wake_up_cond[channel].Signal()
-		wake_up_mutex[channel].Unlock()
-	}
+	tq_append_internal(channel, prio, pp)
 } /* end lm_seize_request */
 
 /*-------------------------------------------------------------------
@@ -648,7 +597,7 @@ func tq_wait_while_empty(channel int) {
 	*/
 	Assert(channel >= 0 && channel < MAX_RADIO_CHANS)
 
-	tq_mutex.Lock()
+	tq_mutex[channel].Lock()
 
 	/* TODO KG
 	#if DEBUG
@@ -658,7 +607,7 @@ func tq_wait_while_empty(channel int) {
 	*/
 	var is_empty = tq_is_empty(channel)
 
-	tq_mutex.Unlock()
+	tq_mutex[channel].Unlock()
 
 	/* TODO KG
 	#if DEBUG
@@ -726,19 +675,11 @@ func tq_remove(channel int, prio int) *packet_t {
 		dw_printf ("tq_remove(%d,%d) enter critical section\n", channel, prio);
 	#endif
 	*/
-	tq_mutex.Lock()
-
-	var result_p *packet_t
+	tq_mutex[channel].Lock()
 
-	if queue_head[channel][prio] == nil {
-		result_p = nil
-	} else {
-		result_p = queue_head[channel][prio]
-		queue_head[channel][prio] = ax25_get_nextp(result_p)
-		ax25_set_nextp(result_p, nil)
-	}
+	var result_p = tq_remove_locked(channel, prio)
 
-	tq_mutex.Unlock()
+	tq_mutex[channel].Unlock()
 
 	/* TODO KG
 	#if DEBUG
@@ -759,6 +700,64 @@ func tq_remove(channel int, prio int) *packet_t {
 	return (result_p)
 } /* end tq_remove */
 
+/* Constant time removal from the head.  Caller must hold tq_mutex[channel]. */
+
+func tq_remove_locked(channel int, prio int) *packet_t {
+	var result_p = queue_head[channel][prio]
+	if result_p == nil {
+		return nil
+	}
+
+	queue_head[channel][prio] = ax25_get_nextp(result_p)
+	if queue_head[channel][prio] == nil {
+		queue_tail[channel][prio] = nil
+	}
+
+	ax25_set_nextp(result_p, nil)
+
+	if ax25_get_num_addr(result_p) >= AX25_MIN_ADDRS {
+		queue_count[channel][prio]--
+		queue_bytes[channel][prio] -= ax25_get_frame_len(result_p)
+	}
+
+	return result_p
+}
+
+/*-------------------------------------------------------------------
+ *
+ * Name:        tq_remove_next
+ *
+ * Purpose:     Remove the most urgent packet waiting for the channel:
+ *		head of the high priority queue if anything is there,
+ *		otherwise head of the low priority queue.
+ *
+ * Inputs:	channel	- Channel, 0 is first.
+ *
+ * Returns:	Pointer to packet object (or nil if both queues empty)
+ *		and the priority it was taken from.
+ *
+ * Description:	Checking both priorities under a single lock acquisition,
+ *		instead of calling tq_remove once per priority, halves the
+ *		locking cost per frame for the transmit thread.
+ *
+ *--------------------------------------------------------------------*/
+
+func tq_remove_next(channel int) (*packet_t, int) {
+	tq_mutex[channel].Lock()
+
+	var prio = TQ_PRIO_0_HI
+
+	var result_p = tq_remove_locked(channel, TQ_PRIO_0_HI)
+	if result_p == nil {
+		prio = TQ_PRIO_1_LO
+		result_p = tq_remove_locked(channel, TQ_PRIO_1_LO)
+	}
+
+	tq_mutex[channel].Unlock()
+
+	return result_p, prio
+} /* end tq_remove_next */
+
 /*-------------------------------------------------------------------
  *
  * Name:        tq_peek
@@ -889,9 +888,27 @@ func tq_count(channel int, prio int, source string, dest string, bytes bool) int
 		return (0)
 	}
 
+	// The common queries - no address filtering - are answered from the
+	// counters maintained at append/remove, without walking the list.
+
+	if source == "" && dest == "" {
+		tq_mutex[channel].Lock()
+
+		var total int
+		if bytes {
+			total = queue_bytes[channel][prio]
+		} else {
+			total = queue_count[channel][prio]
+		}
+
+		tq_mutex[channel].Unlock()
+
+		return total
+	}
+
 	// Don't want lists being rearranged while we are traversing them.
 
-	tq_mutex.Lock()
+	tq_mutex[channel].Lock()
 
 	var n = 0 // Result.  Number of bytes or packets.
 	var pp = queue_head[channel][prio]
@@ -941,7 +958,7 @@ func tq_count(channel int, prio int, source string, dest string, bytes bool) int
 		pp = ax25_get_nextp(pp)
 	}
 
-	tq_mutex.Unlock()
+	tq_mutex[channel].Unlock()
 
 	/* TODO KG
 	#if DEBUG2
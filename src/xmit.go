@@ -36,6 +36,7 @@ import (
 	"os/exec"
 	"strconv"
 	"sync"
+	"sync/atomic"
 	"time"
 
 	"github.com/lestrrat-go/strftime"
@@ -372,14 +373,9 @@ func (xs *XmitService) xmit_thread(channel int) {
 			 */
 			var ok = xs.wait_for_clear_channel(channel, xs.slottime[channel], xs.persist[channel], xs.fulldup[channel])
 
-			var prio = TQ_PRIO_1_LO
+			// Single lock acquisition covering both priority queues.
 
-			var pp = tq_remove(channel, TQ_PRIO_0_HI)
-			if pp != nil {
-				prio = TQ_PRIO_0_HI
-			} else {
-				pp = tq_remove(channel, TQ_PRIO_1_LO)
-			}
+			var pp, prio = tq_remove_next(channel)
 
 			/* TODO KG
 			#if DEBUG
@@ -582,10 +578,51 @@ func (xs *XmitService) xmit_ax25_frames(channel int, prio int, pp *packet_t, max
 	dlq_seize_confirm(channel) // C4.2.  "This primitive indicates, to the Data-link State
 	// machine, that the transmission opportunity has arrived."
 
+	/*
+	 * Pipeline the rendering and the playout.  Each piece of the
+	 * transmission is rendered into a staging buffer and handed to a
+	 * writer goroutine that feeds the audio device.  audio_put_block
+	 * blocks once the device buffer is full, so while one frame is
+	 * still being played out we are already encoding and rendering
+	 * the next one.  That keeps back-to-back frames gapless when the
+	 * data link state machine hands us a whole window at once.
+	 */
+
+	var a = ACHAN2ADEV(channel)
+
+	var stage = make(chan []byte, 1)
+	var stage_done = make(chan struct{})
+	var outstanding atomic.Int32 /* Staged buffers not yet fully handed to the device. */
+
+	go func() {
+		for block := range stage {
+			audio_put_block(a, block)
+			outstanding.Add(-1)
+		}
+
+		close(stage_done)
+	}()
+
+	var stage_rendered = func(render func()) {
+		var buf []byte
+
+		gen_tone_capture_begin(channel, &buf)
+		render()
+		gen_tone_capture_end(channel)
+
+		if len(buf) > 0 {
+			outstanding.Add(1)
+			stage <- buf
+		}
+	}
+
 	var pre_flags = xs.msToBits(xs.txdelay[channel]*10, channel) / 8
 
 	/* Total number of bits in transmission including all flags and bit stuffing. */
-	var num_bits = layer2_preamble_postamble(channel, pre_flags, false, xs.p_modem)
+	var num_bits int
+	stage_rendered(func() {
+		num_bits = layer2_preamble_postamble(channel, pre_flags, false, xs.p_modem)
+	})
 
 	/* TODO KG
 	#if DEBUG
@@ -619,7 +656,10 @@ func (xs *XmitService) xmit_ax25_frames(channel int, prio int, pp *packet_t, max
 	 * Transmit the frame.
 	 */
 
-	var nb = xs.send_one_frame(channel, prio, pp)
+	var nb int
+	stage_rendered(func() {
+		nb = xs.send_one_frame(channel, prio, pp)
+	})
 
 	num_bits += nb
 	if nb > 0 {
@@ -666,7 +706,9 @@ func (xs *XmitService) xmit_ax25_frames(channel int, prio int, pp *packet_t, max
 				#endif
 				*/
 
-				nb = xs.send_one_frame(channel, prio, pp)
+				stage_rendered(func() {
+					nb = xs.send_one_frame(channel, prio, pp)
+				})
 
 				num_bits += nb
 				if nb > 0 {
@@ -680,6 +722,14 @@ func (xs *XmitService) xmit_ax25_frames(channel int, prio int, pp *packet_t, max
 				*/
 				AX25Delete(pp)
 			}
+		} else if outstanding.Load() > 0 {
+			/* Nothing queued right now, but staged audio is still */
+			/* being played out.  The data link state machine may */
+			/* append more frames in response to what has already */
+			/* gone out, so wait for the playout to catch up */
+			/* before ending the transmission. */
+
+			SLEEP_MS(10)
 		} else {
 			done = true
 		}
@@ -690,7 +740,9 @@ func (xs *XmitService) xmit_ax25_frames(channel int, prio int, pp *packet_t, max
 	 */
 
 	var post_flags = xs.msToBits(xs.txtail[channel]*10, channel) / 8
-	nb = layer2_preamble_postamble(channel, post_flags, true, xs.p_modem)
+	stage_rendered(func() {
+		nb = layer2_preamble_postamble(channel, post_flags, true, xs.p_modem)
+	})
 	num_bits += nb
 	/* TODO KG
 	#if DEBUG
@@ -706,7 +758,10 @@ func (xs *XmitService) xmit_ax25_frames(channel int, prio int, pp *packet_t, max
 	 * about 40 mS of elapsed real time.
 	 */
 
-	audio_wait(ACHAN2ADEV(channel))
+	close(stage)
+	<-stage_done
+
+	audio_wait(a)
 
 	/*
 	 * Ideally we should be here just about the time when the audio is ending.